@@ -0,0 +1,336 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <filesystem>
+#include "data_structures/Graph.h"
+#include "io/RailwayReader.h"
+#include "io/NetworkGenerator.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+/**
+
+@brief Options of a benchmark run, set from the command line.
+*/
+struct BenchOptions {
+    string dataset = "../dataset";    // directory holding stations.csv and network.csv
+    vector<int> scales = {1, 4};      // number of copies of the dataset in each synthetic network, 1 for the dataset itself
+    vector<int> generated;            // number of stations of each network written by generateNetwork()
+    int queries = 200;                // single queries timed per network
+    int repetitions = 5;              // repetitions of the whole-network reports and of the CSV load
+    unsigned seed = 16;               // seed of the random stations and pairs
+};
+
+/**
+
+@brief Gets the peak resident set size of the process.
+@return The peak resident set size in kilobytes, or 0 where it cannot be measured.
+*/
+long peakRssKb();
+
+/**
+
+@brief Writes one benchmark result as a JSON object on its own line.
+The latencies are sorted in place and reported as the mean, the 50th, 90th and 99th percentiles (nearest rank) and the
+maximum, in microseconds, together with the throughput in queries per second, the peak resident set size so far and the
+work of the max-flow solvers during the benchmark.
+@param out The stream the result is written to.
+@param benchmark The name of the benchmark.
+@param network The name of the network it ran on.
+@param railway The graph it ran on, whose size is reported.
+@param latencies The duration of every query, in seconds.
+@param stats The work of the max-flow solvers during the benchmark.
+@return void
+*/
+void report(ostream &out, const string &benchmark, const string &network, Graph &railway, vector<double> &latencies, const FlowStats &stats);
+
+/**
+
+@brief Times a function once for every item.
+@param count The number of items.
+@param body The function to time, called with the index of the item.
+@return The duration of every call, in seconds.
+*/
+vector<double> timeEach(int count, const function<void(int)> &body);
+
+/**
+
+@brief Builds a synthetic network made of several copies of a graph.
+Copy k of a station is named "<name> #k" and keeps the district, municipality, township and line of the original. Every
+copy keeps all segments of the original, and consecutive copies are joined at the stations with the most segments, so
+the copies form one connected chain with the same local structure as the original network.
+@param base The graph to copy.
+@param copies The number of copies.
+@param railway The empty graph that receives the network.
+@return void
+*/
+void buildScaledNetwork(Graph &base, int copies, Graph &railway);
+
+/**
+
+@brief Times the CSV load of a network.
+@param out The stream the result is written to.
+@param network The name of the network.
+@param directory The directory holding stations.csv and network.csv.
+@param railway The empty graph that receives the network.
+@param options The options of the run.
+@return true if the network was read, false otherwise.
+*/
+bool benchmarkLoad(ostream &out, const string &network, const string &directory, Graph &railway, const BenchOptions &options);
+
+/**
+
+@brief Runs every benchmark on a network and writes their results.
+The single queries (EdmondsKarp between random pairs and maxTrainsAtStation at random stations) run with the result
+cache disabled, and the caches of the graph are cleared before every repetition of MaxFlowBetweenPairs and topDistricts,
+so every measurement is a cold computation.
+@param out The stream the results are written to.
+@param network The name of the network.
+@param railway The graph to benchmark.
+@param options The options of the run.
+@return void
+*/
+void benchmarkNetwork(ostream &out, const string &network, Graph &railway, const BenchOptions &options);
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++) {
+        string arg = argv[i];
+        if (i + 1 == argc) {
+            valid = false;
+            break;
+        }
+        string value = argv[++i];
+        if (arg == "--dataset") {
+            options.dataset = value;
+        } else if (arg == "--scales") {
+            options.scales.clear();
+            stringstream ss(value);
+            string scale;
+            while (getline(ss, scale, ',')) {
+                int copies = atoi(scale.c_str());
+                if (copies < 1) valid = false;
+                options.scales.push_back(copies);
+            }
+        } else if (arg == "--generated") {
+            stringstream ss(value);
+            string size;
+            while (getline(ss, size, ',')) {
+                int stations = atoi(size.c_str());
+                if (stations < 2) valid = false;
+                options.generated.push_back(stations);
+            }
+        } else if (arg == "--queries") {
+            options.queries = atoi(value.c_str());
+        } else if (arg == "--repetitions") {
+            options.repetitions = atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = (unsigned) strtoul(value.c_str(), nullptr, 10);
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid || options.queries < 1 || options.repetitions < 1) {
+        cerr << "Usage: " << argv[0] << " [--dataset DIR] [--scales 1,4,...] [--generated N,...] [--queries N] [--repetitions N] [--seed N]" << endl;
+        return 1;
+    }
+    Graph dataset;
+    if (!benchmarkLoad(cout, "dataset", options.dataset, dataset, options)) {
+        return 1;
+    }
+
+    for (int copies : options.scales) {
+        if (copies == 1) {
+            benchmarkNetwork(cout, "dataset", dataset, options);
+        } else {
+            Graph railway;
+            buildScaledNetwork(dataset, copies, railway);
+            benchmarkNetwork(cout, "dataset_x" + to_string(copies), railway, options);
+        }
+    }
+
+    for (int size : options.generated) {
+        GeneratorOptions generator;
+        generator.stations = size;
+        generator.seed = options.seed;
+        filesystem::path directory = filesystem::temp_directory_path() / ("G16_3_bench_" + to_string(size));
+        filesystem::create_directories(directory);
+        {
+            ofstream stations(directory / "stations.csv");
+            ofstream network(directory / "network.csv");
+            generateNetwork(generator, stations, network);
+        }
+        Graph railway;
+        string name = "generated_" + to_string(size);
+        bool read = benchmarkLoad(cout, name, directory.string(), railway, options);
+        filesystem::remove_all(directory);
+        if (!read) return 1;
+        benchmarkNetwork(cout, name, railway, options);
+    }
+    return 0;
+}
+
+bool benchmarkLoad(ostream &out, const string &network, const string &directory, Graph &railway, const BenchOptions &options) {
+    string stations = directory + "/stations.csv";
+    string segments = directory + "/network.csv";
+
+    // The CSV load is timed on its own, without the snapshot used by the application
+    try {
+        vector<double> loads = timeEach(options.repetitions, [&](int) {
+            Graph loaded;
+            readStations(loaded, stations);
+            readNetwork(loaded, segments);
+        });
+        readStations(railway, stations);
+        readNetwork(railway, segments);
+        report(out, "csv_load", network, railway, loads, FlowStats());
+    } catch (const std::runtime_error &e) {
+        cerr << e.what() << endl;
+        return false;
+    }
+    return true;
+}
+
+long peakRssKb() {
+#if defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024;
+#elif defined(__unix__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#else
+    return 0;
+#endif
+}
+
+void report(ostream &out, const string &benchmark, const string &network, Graph &railway, vector<double> &latencies, const FlowStats &stats) {
+    sort(latencies.begin(), latencies.end());
+    double total = 0.0;
+    for (double latency : latencies) total += latency;
+    auto percentile = [&](double p) {
+        size_t rank = (size_t) max(1.0, ceil(p * latencies.size()));
+        return latencies[rank - 1] * 1e6;
+    };
+
+    size_t segments = 0;
+    for (Vertex *v : railway.getVertexSet()) segments += v->getAdj().size();
+    out << "{\"benchmark\":\"" << benchmark << "\",\"network\":\"" << network << "\""
+        << ",\"stations\":" << railway.getVertexSet().size() << ",\"segments\":" << segments / 2
+        << ",\"count\":" << latencies.size()
+        << ",\"qps\":" << (total > 0.0 ? latencies.size() / total : 0.0)
+        << ",\"mean_us\":" << total / latencies.size() * 1e6
+        << ",\"p50_us\":" << percentile(0.50) << ",\"p90_us\":" << percentile(0.90) << ",\"p99_us\":" << percentile(0.99)
+        << ",\"max_us\":" << latencies.back() * 1e6
+        << ",\"peak_rss_kb\":" << peakRssKb() << ",\"flow_stats\":";
+    stats.dump(out);
+    out << "}" << endl;
+}
+
+vector<double> timeEach(int count, const function<void(int)> &body) {
+    vector<double> latencies(count);
+    for (int i = 0; i < count; i++) {
+        auto start = chrono::steady_clock::now();
+        body(i);
+        auto end = chrono::steady_clock::now();
+        latencies[i] = chrono::duration<double>(end - start).count();
+    }
+    return latencies;
+}
+
+void buildScaledNetwork(Graph &base, int copies, Graph &railway) {
+    vector<Vertex *> stations = base.getVertexSet();
+    for (int k = 0; k < copies; k++) {
+        for (Vertex *v : stations) {
+            railway.addVertex(v->getName() + " #" + to_string(k), v->getDistrict(), v->getMunicipality(), v->getTownship(), v->getLine());
+        }
+    }
+    vector<Vertex *> vertices = railway.getVertexSet();
+    int n = (int) stations.size();
+    double widest = 0.0;
+    for (int k = 0; k < copies; k++) {
+        for (Vertex *v : stations) {
+            for (Edge *e : v->getAdj()) {
+                // Each segment appears in the adjacency of both of its stations
+                if (e->getDest()->getId() < v->getId()) continue;
+                railway.addBidirectionalEdge(vertices[k * n + v->getId()], vertices[k * n + e->getDest()->getId()], e->getWeight(), e->getService());
+                widest = max(widest, e->getWeight());
+            }
+        }
+    }
+
+    vector<Vertex *> hubs = stations;
+    sort(hubs.begin(), hubs.end(), [](Vertex *left, Vertex *right) {
+        if (left->getAdj().size() != right->getAdj().size()) return left->getAdj().size() > right->getAdj().size();
+        return left->getId() < right->getId();
+    });
+    hubs.resize(min((size_t) 3, hubs.size()));
+    for (int k = 0; k + 1 < copies; k++) {
+        for (Vertex *hub : hubs) {
+            railway.addBidirectionalEdge(vertices[k * n + hub->getId()], vertices[(k + 1) * n + hub->getId()], widest, "STANDARD");
+        }
+    }
+}
+
+void benchmarkNetwork(ostream &out, const string &network, Graph &railway, const BenchOptions &options) {
+    vector<Vertex *> stations = railway.getVertexSet();
+    mt19937 random(options.seed);
+    uniform_int_distribution<int> pick(0, (int) stations.size() - 1);
+    vector<pair<Vertex *, Vertex *>> pairs(options.queries);
+    for (auto &pair : pairs) {
+        do {
+            pair = {stations[pick(random)], stations[pick(random)]};
+        } while (pair.first == pair.second);
+    }
+
+    size_t cacheCapacity = railway.getResultCache().getCapacity();
+    railway.getResultCache().setCapacity(0);
+    railway.getFlowNetwork();
+
+    railway.resetFlowStats();
+    vector<double> latencies = timeEach(options.queries, [&](int i) {
+        railway.EdmondsKarp(pairs[i].first, pairs[i].second);
+    });
+    report(out, "edmonds_karp", network, railway, latencies, railway.getFlowStats());
+
+    railway.resetFlowStats();
+
+    latencies = timeEach(options.queries, [&](int i) {
+        railway.getMaxTrainsAtStation(pairs[i].first);
+    });
+    report(out, "max_trains_at_station", network, railway, latencies, railway.getFlowStats());
+    railway.getResultCache().setCapacity(cacheCapacity);
+
+    // The reports print their results, which are not part of the measurement
+    ostringstream discarded;
+    streambuf *console = cout.rdbuf(discarded.rdbuf());
+    railway.resetFlowStats();
+    latencies = timeEach(options.repetitions, [&](int) {
+        railway.clearCaches();
+        railway.MaxFlowBetweenPairs();
+        discarded.str("");
+    });
+    FlowStats pairsStats = railway.getFlowStats();
+    railway.resetFlowStats();
+    vector<double> districts = timeEach(options.repetitions, [&](int) {
+        railway.clearCaches();
+        railway.topDistricts(5);
+        discarded.str("");
+    });
+    cout.rdbuf(console);
+    report(out, "max_flow_between_pairs", network, railway, latencies, pairsStats);
+    report(out, "top_districts", network, railway, districts, railway.getFlowStats());
+}
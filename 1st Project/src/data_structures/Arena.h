@@ -0,0 +1,129 @@
+#ifndef G16_3_ARENA_H
+#define G16_3_ARENA_H
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Chunked arena of objects of one type, which owns them and frees them all at once.
+ *
+ * Objects are constructed one after the other in chunks of a fixed number of slots, so creating n objects costs about
+ * n / chunkSize allocations and objects created together lie next to each other in memory. Objects are never moved, so
+ * pointers to them stay valid until they are destroyed. A destroyed object leaves a slot that the next creation reuses.
+ * Each slot records its own index after the object, so destroying an object finds its slot in O(1).
+ * Destroying the arena runs the destructor of every object still alive, skipped entirely for trivially destructible
+ * types, and then frees the chunks.
+ *
+ * @tparam T The type of the objects.
+ */
+template <class T>
+class Arena {
+public:
+    /**
+     * @brief Creates an empty arena.
+     *
+     * @param chunkSize The number of objects of each chunk.
+     */
+    explicit Arena(size_t chunkSize = 1024): chunkSize(chunkSize == 0 ? 1 : chunkSize) {}
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Destroys every object still alive and frees the chunks.
+     *
+     * Time Complexity: O(n) for types with a destructor, O(number of chunks) otherwise
+     */
+    ~Arena() {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < used; i++) {
+                if (live[i]) slot(i)->~T();
+            }
+        }
+    }
+
+    /**
+     * @brief Constructs an object in the next free slot.
+     *
+     * @param args The arguments of the constructor of T.
+     * @return A pointer to the object, valid until it is destroyed or the arena is.
+     * Time Complexity: O(1) amortized
+     */
+    template <class... Args>
+    T *create(Args &&...args) {
+        size_t i;
+        if (!freeSlots.empty()) {
+            i = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (used == chunks.size() * chunkSize) {
+                chunks.emplace_back(new Slot[chunkSize]);
+            }
+            i = used++;
+            live.push_back(false);
+        }
+        T *object = new (slot(i)) T(std::forward<Args>(args)...);
+        chunks[i / chunkSize][i % chunkSize].index = i;
+        live[i] = true;
+        return object;
+    }
+
+    /**
+     * @brief Destroys an object created by this arena and makes its slot available again.
+     *
+     * @param object The object.
+     * Time Complexity: O(1)
+     */
+    void destroy(T *object) {
+        size_t i = indexOf(object);
+        object->~T();
+        live[i] = false;
+        freeSlots.push_back(i);
+    }
+
+    /**
+     * @brief Gets the number of objects alive.
+     *
+     * @return The number of objects created and not yet destroyed.
+     */
+    size_t size() const {
+        return used - freeSlots.size();
+    }
+
+protected:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];  // first, so a pointer to the object is a pointer to its slot
+        size_t index;                               // index of the slot, in creation order
+    };
+
+    /**
+     * @brief Gets the storage of a slot.
+     *
+     * @param i The index of the slot, in creation order.
+     * @return The storage of the slot, as a pointer to T.
+     */
+    T *slot(size_t i) const {
+        return reinterpret_cast<T *>(chunks[i / chunkSize][i % chunkSize].bytes);
+    }
+
+    /**
+     * @brief Gets the index of the slot that holds an object.
+     *
+     * @param object An object created by this arena.
+     * @return The index of its slot.
+     */
+    size_t indexOf(const T *object) const {
+        return reinterpret_cast<const Slot *>(object)->index;
+    }
+
+    size_t chunkSize;
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    size_t used = 0;                    // slots handed out so far, alive or not
+    std::vector<bool> live;             // whether each slot holds an object
+    std::vector<size_t> freeSlots;      // slots whose object was destroyed
+};
+
+#endif //G16_3_ARENA_H
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <memory>
+#include "ContingencySweep.h"
+#include "Parallel.h"
+
+ContingencySweep::ContingencySweep(const FlowNetwork &network, const std::vector<std::pair<int, int>> &pairs, FlowAlgorithm algorithm, unsigned threads) {
+    unsigned workers = resolveThreads(threads);
+    std::vector<std::unique_ptr<FlowContext>> contexts(workers);
+    auto contextOf = [&](unsigned w) -> FlowContext & {
+        if (contexts[w] == nullptr) {
+            contexts[w] = std::make_unique<FlowContext>(network);
+        }
+        return *contexts[w];
+    };
+
+    // Each segment is the pair of opposite arcs {a, reverse(a)}, identified by its lower arc
+    std::vector<int> segmentOf(network.getNumArcs(), -1);
+    for (int u = 0; u < network.getNumVertices(); u++) {
+        for (int a = network.getArcsBegin(u); a < network.getArcsEnd(u); a++) {
+            if (a > network.getReverse(a)) continue;
+            segmentOf[a] = segmentOf[network.getReverse(a)] = (int) ranking.size();
+            ranking.push_back({a, network.vertexAt(u), network.vertexAt(network.getHead(a)), (double) network.getCapacities()[a], 0.0, 0});
+        }
+    }
+
+    // Maximum flow of every pair on the full network, and the segments its flow crosses
+    FlowAlgorithm baseAlgorithm = algorithm == FlowAlgorithm::PushRelabel ? FlowAlgorithm::Dinic : algorithm;
+    std::vector<double> flows(pairs.size(), 0.0);
+    std::vector<std::vector<std::pair<int, Capacity>>> arcFlows(pairs.size());
+    parallelFor(pairs.size(), workers, [&](unsigned w, size_t p) {
+        int s = pairs[p].first;
+        int t = pairs[p].second;
+        if (s == t) return;
+        FlowContext &ctx = contextOf(w);
+        flows[p] = network.maxFlow(s, t, baseAlgorithm, ctx);
+        ctx.saveFlows(arcFlows[p]);
+    });
+    std::vector<std::vector<int>> pairsOf(ranking.size());
+    for (size_t p = 0; p < pairs.size(); p++) {
+        baseFlow += flows[p];
+        for (const auto &entry : arcFlows[p]) {
+            // Both arcs of a segment carry the flow, once with each sign: only count the positive one
+            if (entry.second > 0) pairsOf[segmentOf[entry.first]].push_back((int) p);
+        }
+    }
+
+    std::vector<std::vector<Capacity>> capacities(workers);
+    parallelFor(ranking.size(), workers, [&](unsigned w, size_t i) {
+        if (pairsOf[i].empty()) return;
+        FlowContext &ctx = contextOf(w);
+        if (capacities[w].empty()) {
+            capacities[w] = network.getCapacities();
+        }
+        SegmentFailure &failure = ranking[i];
+        std::vector<int> changedArcs = {failure.arc, network.getReverse(failure.arc)};
+        for (int a : changedArcs) {
+            capacities[w][a] = 0;
+        }
+        ctx.setCapacities(&capacities[w]);
+        for (int p : pairsOf[i]) {
+            ctx.loadFlows(arcFlows[p]);
+            double lost = flows[p] - network.repairMaxFlow(pairs[p].first, pairs[p].second, changedArcs, algorithm, ctx);
+            if (lost > 0.0) {
+                failure.loss += lost;
+                failure.affectedPairs++;
+            }
+        }
+        ctx.setCapacities(nullptr);
+        for (int a : changedArcs) {
+            capacities[w][a] = network.getCapacities()[a];
+        }
+    });
+
+    std::stable_sort(ranking.begin(), ranking.end(), [](const SegmentFailure &left, const SegmentFailure &right) {
+        return left.loss > right.loss;
+    });
+    for (const auto &ctx : contexts) {
+        if (ctx != nullptr) stats.merge(ctx->getStats());
+    }
+}
+
+const std::vector<SegmentFailure> &ContingencySweep::getRanking() const {
+    return ranking;
+}
+
+double ContingencySweep::getBaseFlow() const {
+    return baseFlow;
+}
+
+const FlowStats &ContingencySweep::getStats() const {
+    return stats;
+}
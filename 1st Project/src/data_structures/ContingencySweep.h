@@ -0,0 +1,69 @@
+#ifndef G16_3_CONTINGENCYSWEEP_H
+#define G16_3_CONTINGENCYSWEEP_H
+#include <utility>
+#include <vector>
+#include "FlowNetwork.h"
+
+/**
+ * @brief Flow lost by a set of origin-destination pairs when one segment fails.
+ */
+struct SegmentFailure {
+    int arc;            // arc of the segment in the network, from origin to destination
+    Vertex *origin;     // one station of the segment
+    Vertex *destination;    // the other station of the segment
+    double capacity;    // capacity of the segment
+    double loss;        // total maximum flow lost over the pairs
+    int affectedPairs;  // number of pairs that lose flow
+};
+
+/**
+ * @brief N-1 contingency analysis: the flow lost over a set of origin-destination pairs when each segment fails on its own.
+ *
+ * The maximum flow of every pair is computed once on the full network and kept as the list of arcs it uses. A segment that
+ * carries no flow of a pair cannot reduce that pair's maximum flow, so each segment is only evaluated for the pairs whose flow
+ * crosses it, and each such evaluation repairs the saved flow with FlowNetwork::repairMaxFlow instead of recomputing it.
+ * Segments are distributed over a pool of worker threads with parallelFor, each with its own FlowContext and capacities,
+ * and every result is written by a single worker, so the ranking does not depend on the number of threads.
+ */
+class ContingencySweep {
+public:
+    /**
+     * @brief Runs the sweep over every segment of a network.
+     *
+     * @param network The residual network.
+     * @param pairs The origin-destination pairs, as vertex indices; pairs of a vertex with itself are ignored.
+     * @param algorithm The max-flow algorithm used to compute and repair the flows; push-relabel computes the flows of the
+     * full network with Dinic, since the repair needs complete flows.
+     * @param threads The number of worker threads, 0 for one per hardware thread.
+     * Time Complexity: P max-flow computations plus one repair for every segment crossed by the flow of each pair
+     */
+    ContingencySweep(const FlowNetwork &network, const std::vector<std::pair<int, int>> &pairs, FlowAlgorithm algorithm, unsigned threads);
+
+    /**
+     * @brief Gets the segments ranked by decreasing flow loss, ties kept in network order.
+     *
+     * @return The failures of every segment of the network.
+     */
+    const std::vector<SegmentFailure> &getRanking() const;
+
+    /**
+     * @brief Gets the total maximum flow of the pairs on the full network.
+     *
+     * @return The sum of the maximum flows of the pairs.
+     */
+    double getBaseFlow() const;
+
+    /**
+     * @brief Gets the work done by the max-flow solvers while sweeping the segments.
+     *
+     * @return The statistics, summed over every worker.
+     */
+    const FlowStats &getStats() const;
+
+protected:
+    std::vector<SegmentFailure> ranking;
+    double baseFlow = 0.0;
+    FlowStats stats;
+};
+
+#endif //G16_3_CONTINGENCYSWEEP_H
@@ -0,0 +1,814 @@
+#include <unordered_map>
+#include "FlowNetwork.h"
+
+template <class Cap>
+BasicFlowContext<Cap>::BasicFlowContext(const BasicFlowNetwork<Cap> &network) {
+    int n = network.getNumVertices();
+    capacity = networkCapacity = network.getCapacities().data();
+    flow.assign(network.getNumArcs(), 0);
+    flowStamp.assign(network.getNumArcs(), 0);
+    visitStamp.assign(n, 0);
+    parentArc.assign(n, -1);
+    queue.reserve(n);
+    sinkVisitStamp.assign(n, 0);
+    childArc.assign(n, -1);
+    sinkQueue.reserve(n);
+    level.assign(n, -1);
+    current.assign(n, 0);
+    height.assign(n, 0);
+    excess.assign(n, 0);
+    heightCount.assign(n + 1, 0);
+    buckets.resize(n + 1);
+    sourceBudget.assign(n, 0);
+    sinkBudget.assign(n, 0);
+}
+
+template <class Cap>
+void BasicFlowContext<Cap>::begin() {
+    if (++epoch == 0) {
+        std::fill(flowStamp.begin(), flowStamp.end(), 0);
+        epoch = 1;
+    }
+}
+
+template <class Cap>
+void BasicFlowContext<Cap>::setCapacities(const std::vector<Cap> *capacities) {
+    capacity = capacities == nullptr ? networkCapacity : capacities->data();
+}
+
+template <class Cap>
+void BasicFlowContext<Cap>::saveFlows(std::vector<std::pair<int, Cap>> &flows) const {
+    flows.clear();
+    for (int a = 0; a < (int) flow.size(); a++) {
+        Cap f = getFlow(a);
+        if (f != 0) flows.emplace_back(a, f);
+    }
+}
+
+template <class Cap>
+void BasicFlowContext<Cap>::loadFlows(const std::vector<std::pair<int, Cap>> &flows) {
+    begin();
+    for (const auto &entry : flows) {
+        addFlow(entry.first, entry.second);
+    }
+}
+
+template <class Cap>
+const FlowStats &BasicFlowContext<Cap>::getStats() const {
+    return stats;
+}
+
+template <class Cap>
+void BasicFlowContext<Cap>::resetStats() {
+    stats = FlowStats();
+}
+
+template <class Cap>
+void BasicFlowContext<Cap>::newSearch() {
+    if (++searchEpoch == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        std::fill(sinkVisitStamp.begin(), sinkVisitStamp.end(), 0);
+        searchEpoch = 1;
+    }
+}
+
+template <class Cap>
+BasicFlowContextPool<Cap>::BasicFlowContextPool(std::shared_ptr<const BasicFlowNetwork<Cap>> network): network(std::move(network)) {}
+
+template <class Cap>
+const BasicFlowNetwork<Cap> &BasicFlowContextPool<Cap>::getNetwork() const {
+    return *network;
+}
+
+template <class Cap>
+std::unique_ptr<BasicFlowContext<Cap>> BasicFlowContextPool<Cap>::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!available.empty()) {
+            std::unique_ptr<BasicFlowContext<Cap>> ctx = std::move(available.back());
+            available.pop_back();
+            return ctx;
+        }
+    }
+    return std::make_unique<BasicFlowContext<Cap>>(*network);
+}
+
+template <class Cap>
+void BasicFlowContextPool<Cap>::release(std::unique_ptr<BasicFlowContext<Cap>> ctx) {
+    std::lock_guard<std::mutex> lock(mutex);
+    available.push_back(std::move(ctx));
+}
+
+template <class Cap>
+BasicFlowNetwork<Cap>::BasicFlowNetwork(const std::vector<Vertex *> &vertexSet): vertices(vertexSet) {
+    int n = (int) vertices.size();
+
+    // An edge keeps its own reverse when the opposite edge is also in the network, otherwise a zero capacity arc is added
+    auto hasReverse = [this](const Edge *e) {
+        const Edge *r = e->getReverse();
+        return r != nullptr && r->getReverse() == e && indexOf(r->getOrig()) != -1;
+    };
+
+    first.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        for (Edge *e : vertices[i]->getAdj()) {
+            int d = indexOf(e->getDest());
+            if (d == -1) continue;
+            first[i + 1]++;
+            if (!hasReverse(e)) first[d + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        first[i + 1] += first[i];
+    }
+
+    int m = first[n];
+    head.assign(m, -1);
+    capacity.assign(m, 0);
+    reverse.assign(m, -1);
+    edges.assign(m, nullptr);
+
+    std::vector<int> next(first.begin(), first.end() - 1);
+    std::unordered_map<const Edge *, int> arcOf;
+    arcOf.reserve(m);
+    for (int i = 0; i < n; i++) {
+        for (Edge *e : vertices[i]->getAdj()) {
+            int d = indexOf(e->getDest());
+            if (d == -1) continue;
+            int a = next[i]++;
+            head[a] = d;
+            capacity[a] = toCapacity<Cap>(e->getWeight());
+            edges[a] = e;
+            arcOf[e] = a;
+            if (!hasReverse(e)) {
+                int r = next[d]++;
+                head[r] = i;
+                reverse[a] = r;
+                reverse[r] = a;
+            }
+        }
+    }
+    for (auto &entry : arcOf) {
+        const Edge *e = entry.first;
+        if (reverse[entry.second] == -1) {
+            reverse[entry.second] = arcOf[e->getReverse()];
+        }
+    }
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::getNumVertices() const {
+    return (int) vertices.size();
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::getNumArcs() const {
+    return (int) head.size();
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::indexOf(const Vertex *v) const {
+    int id = v->getId();
+    if (id < 0 || id >= (int) vertices.size() || vertices[id] != v) return -1;
+    return id;
+}
+
+template <class Cap>
+Vertex *BasicFlowNetwork<Cap>::vertexAt(int i) const {
+    return vertices[i];
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::getArcsBegin(int u) const {
+    return first[u];
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::getArcsEnd(int u) const {
+    return first[u + 1];
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::getHead(int a) const {
+    return head[a];
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::getReverse(int a) const {
+    return reverse[a];
+}
+
+template <class Cap>
+int BasicFlowNetwork<Cap>::arcOf(const Edge *e) const {
+    int u = indexOf(e->getOrig());
+    if (u == -1) return -1;
+    for (int a = first[u]; a < first[u + 1]; a++) {
+        if (edges[a] == e) return a;
+    }
+    return -1;
+}
+
+template <class Cap>
+const std::vector<Cap> &BasicFlowNetwork<Cap>::getCapacities() const {
+    return capacity;
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::augment(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    int meetArc = -1, meetLength = std::numeric_limits<int>::max();
+    {
+        PhaseTimer timer(ctx.stats.searchSeconds);
+        ctx.newSearch();
+        ctx.queue.clear();
+        ctx.queue.push_back(s);
+        ctx.visit(s);
+        ctx.level[s] = 0;
+        ctx.sinkQueue.clear();
+        ctx.sinkQueue.push_back(t);
+        ctx.visitFromSink(t);
+        ctx.level[t] = 0;
+
+        // Every vertex belongs to at most one tree, so level holds its distance from the root of its own tree
+        size_t sourceBegin = 0, sinkBegin = 0;
+        while (meetArc == -1 && sourceBegin < ctx.queue.size() && sinkBegin < ctx.sinkQueue.size()) {
+            if (ctx.queue.size() - sourceBegin <= ctx.sinkQueue.size() - sinkBegin) {
+                size_t end = ctx.queue.size();
+                for (; sourceBegin < end; sourceBegin++) {
+                    int u = ctx.queue[sourceBegin];
+                    ctx.stats.verticesDequeued++;
+                    ctx.stats.edgesScanned += first[u + 1] - first[u];
+                    for (int a = first[u]; a < first[u + 1]; a++) {
+                        int v = head[a];
+                        if (ctx.isVisited(v) || ctx.capacity[a] - ctx.getFlow(a) <= 0) continue;
+                        if (ctx.isVisitedFromSink(v)) {
+                            if (ctx.level[u] + 1 + ctx.level[v] < meetLength) {
+                                meetArc = a;
+                                meetLength = ctx.level[u] + 1 + ctx.level[v];
+                            }
+                            continue;
+                        }
+                        ctx.visit(v);
+                        ctx.parentArc[v] = a;
+                        ctx.level[v] = ctx.level[u] + 1;
+                        ctx.queue.push_back(v);
+                    }
+                }
+            } else {
+                size_t end = ctx.sinkQueue.size();
+                for (; sinkBegin < end; sinkBegin++) {
+                    int w = ctx.sinkQueue[sinkBegin];
+                    ctx.stats.verticesDequeued++;
+                    ctx.stats.edgesScanned += first[w + 1] - first[w];
+                    for (int b = first[w]; b < first[w + 1]; b++) {
+                        int x = head[b], r = reverse[b];  // r is the arc x -> w
+                        if (ctx.isVisitedFromSink(x) || ctx.capacity[r] - ctx.getFlow(r) <= 0) continue;
+                        if (ctx.isVisited(x)) {
+                            if (ctx.level[x] + 1 + ctx.level[w] < meetLength) {
+                                meetArc = r;
+                                meetLength = ctx.level[x] + 1 + ctx.level[w];
+                            }
+                            continue;
+                        }
+                        ctx.visitFromSink(x);
+                        ctx.childArc[x] = r;
+                        ctx.level[x] = ctx.level[w] + 1;
+                        ctx.sinkQueue.push_back(x);
+                    }
+                }
+            }
+        }
+    }
+    if (meetArc == -1) return 0;
+
+    // The path is the source tree down to the tail of meetArc, meetArc itself, and the target tree from its head
+    PhaseTimer timer(ctx.stats.augmentSeconds);
+    int x = head[reverse[meetArc]], y = head[meetArc];
+    Cap bottleNeck = ctx.capacity[meetArc] - ctx.getFlow(meetArc);
+    for (int v = x; v != s; v = head[reverse[ctx.parentArc[v]]]) {
+        int a = ctx.parentArc[v];
+        bottleNeck = std::min(bottleNeck, ctx.capacity[a] - ctx.getFlow(a));
+    }
+    for (int v = y; v != t; v = head[ctx.childArc[v]]) {
+        int a = ctx.childArc[v];
+        bottleNeck = std::min(bottleNeck, ctx.capacity[a] - ctx.getFlow(a));
+    }
+    ctx.addFlow(meetArc, bottleNeck);
+    ctx.addFlow(reverse[meetArc], -bottleNeck);
+    for (int v = x; v != s; v = head[reverse[ctx.parentArc[v]]]) {
+        int a = ctx.parentArc[v];
+        ctx.addFlow(a, bottleNeck);
+        ctx.addFlow(reverse[a], -bottleNeck);
+    }
+    for (int v = y; v != t; v = head[ctx.childArc[v]]) {
+        int a = ctx.childArc[v];
+        ctx.addFlow(a, bottleNeck);
+        ctx.addFlow(reverse[a], -bottleNeck);
+    }
+    ctx.stats.recordPath(bottleNeck);
+    return bottleNeck;
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::EdmondsKarp(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    if (s == t) return 0;
+    ctx.begin();
+    ctx.stats.computations++;
+    return augmentToMax(s, t, FlowAlgorithm::EdmondsKarp, ctx);
+}
+
+template <class Cap>
+bool BasicFlowNetwork<Cap>::buildLevels(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    ctx.newSearch();
+    ctx.queue.clear();
+    ctx.queue.push_back(s);
+    ctx.visit(s);
+    ctx.level[s] = 0;
+
+    for (size_t q = 0; q < ctx.queue.size(); q++) {
+        int u = ctx.queue[q];
+        if (ctx.isVisited(t) && ctx.level[u] >= ctx.level[t]) break; // vertices past the target's level are never used
+        ctx.stats.verticesDequeued++;
+        ctx.stats.edgesScanned += first[u + 1] - first[u];
+        for (int a = first[u]; a < first[u + 1]; a++) {
+            int v = head[a];
+            if (ctx.isVisited(v) || ctx.capacity[a] - ctx.getFlow(a) <= 0) continue;
+            ctx.visit(v);
+            ctx.level[v] = ctx.level[u] + 1;
+            ctx.queue.push_back(v);
+        }
+    }
+    return ctx.isVisited(t);
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::blockingPath(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    ctx.pathArcs.clear();
+    int u = s;
+    while (u != t) {
+        int &a = ctx.current[u];
+        while (a < first[u + 1] && (ctx.levelOf(head[a]) != ctx.level[u] + 1 || ctx.capacity[a] - ctx.getFlow(a) <= 0)) {
+            ctx.stats.edgesScanned++;
+            a++;
+        }
+        if (a < first[u + 1]) {
+            ctx.pathArcs.push_back(a);
+            u = head[a];
+            continue;
+        }
+        // Dead end: prune u from the level graph and retreat along the path
+        ctx.level[u] = -1;
+        if (ctx.pathArcs.empty()) return 0;
+        u = head[reverse[ctx.pathArcs.back()]];
+        ctx.pathArcs.pop_back();
+        ctx.current[u]++;
+    }
+
+    Cap bottleNeck = std::numeric_limits<Cap>::max();
+    for (int a : ctx.pathArcs) {
+        bottleNeck = std::min(bottleNeck, ctx.capacity[a] - ctx.getFlow(a));
+    }
+    for (int a : ctx.pathArcs) {
+        ctx.addFlow(a, bottleNeck);
+        ctx.addFlow(reverse[a], -bottleNeck);
+    }
+    ctx.stats.edgesScanned += ctx.pathArcs.size();
+    ctx.stats.recordPath(bottleNeck);
+    return bottleNeck;
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::Dinic(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    if (s == t) return 0;
+    ctx.begin();
+    ctx.stats.computations++;
+    return augmentToMax(s, t, FlowAlgorithm::Dinic, ctx);
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::augmentToMax(int s, int t, FlowAlgorithm algorithm, BasicFlowContext<Cap> &ctx) const {
+    Cap maxFlow = 0;
+    Cap f;
+    if (algorithm == FlowAlgorithm::EdmondsKarp) {
+        while ((f = augment(s, t, ctx)) > 0) {
+            maxFlow += f;
+        }
+        return maxFlow;
+    }
+    while (true) {
+        {
+            PhaseTimer timer(ctx.stats.searchSeconds);
+            if (!buildLevels(s, t, ctx)) break;
+        }
+        PhaseTimer timer(ctx.stats.augmentSeconds);
+        std::copy(first.begin(), first.end() - 1, ctx.current.begin());
+        while ((f = blockingPath(s, t, ctx)) > 0) {
+            maxFlow += f;
+        }
+    }
+    return maxFlow;
+}
+
+template <class Cap>
+void BasicFlowNetwork<Cap>::globalRelabel(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    PhaseTimer timer(ctx.stats.searchSeconds);
+    int n = getNumVertices();
+    std::fill(ctx.height.begin(), ctx.height.end(), n);
+    std::fill(ctx.heightCount.begin(), ctx.heightCount.end(), 0);
+    for (auto &bucket : ctx.buckets) {
+        bucket.clear();
+    }
+
+    // Reverse BFS from t: arc a leaves u, so reverse[a] enters u and v = head[a] can push to u through it
+    ctx.queue.clear();
+    ctx.queue.push_back(t);
+    ctx.height[t] = 0;
+    for (size_t q = 0; q < ctx.queue.size(); q++) {
+        int u = ctx.queue[q];
+        ctx.heightCount[ctx.height[u]]++;
+        ctx.stats.verticesDequeued++;
+        ctx.stats.edgesScanned += first[u + 1] - first[u];
+        for (int a = first[u]; a < first[u + 1]; a++) {
+            int v = head[a];
+            int r = reverse[a];
+            if (v == s || ctx.height[v] != n || ctx.capacity[r] - ctx.getFlow(r) <= 0) continue;
+            ctx.height[v] = ctx.height[u] + 1;
+            ctx.queue.push_back(v);
+        }
+    }
+
+    ctx.highest = -1;
+    for (int v = 0; v < n; v++) {
+        ctx.current[v] = first[v];
+        if (v != s && v != t && ctx.excess[v] > 0 && ctx.height[v] < n) {
+            ctx.buckets[ctx.height[v]].push_back(v);
+            ctx.highest = std::max(ctx.highest, ctx.height[v]);
+        }
+    }
+    ctx.relabels = 0;
+}
+
+template <class Cap>
+void BasicFlowNetwork<Cap>::gapRelabel(int h, BasicFlowContext<Cap> &ctx) const {
+    int n = getNumVertices();
+    for (int v = 0; v < n; v++) {
+        if (ctx.height[v] >= h && ctx.height[v] < n) {
+            ctx.heightCount[ctx.height[v]]--;
+            ctx.height[v] = n;
+        }
+    }
+}
+
+template <class Cap>
+void BasicFlowNetwork<Cap>::discharge(int u, int s, int t, BasicFlowContext<Cap> &ctx) const {
+    int n = getNumVertices();
+    while (ctx.excess[u] > 0) {
+        if (ctx.current[u] == first[u + 1]) {
+            // Relabel: lift u just above its lowest residual neighbour
+            int oldHeight = ctx.height[u];
+            int newHeight = n;
+            for (int a = first[u]; a < first[u + 1]; a++) {
+                if (ctx.capacity[a] - ctx.getFlow(a) > 0) {
+                    newHeight = std::min(newHeight, ctx.height[head[a]] + 1);
+                }
+            }
+            ctx.relabels++;
+            ctx.stats.relabels++;
+            ctx.stats.edgesScanned += first[u + 1] - first[u];
+            if (ctx.heightCount[oldHeight] == 1) {
+                gapRelabel(oldHeight, ctx);
+                return;
+            }
+            ctx.heightCount[oldHeight]--;
+            if (newHeight >= n) {
+                ctx.height[u] = n;
+                return;
+            }
+            ctx.height[u] = newHeight;
+            ctx.heightCount[newHeight]++;
+            ctx.current[u] = first[u];
+            continue;
+        }
+
+        int a = ctx.current[u];
+        int v = head[a];
+        Cap residual = ctx.capacity[a] - ctx.getFlow(a);
+        ctx.stats.edgesScanned++;
+        if (residual > 0 && ctx.height[u] == ctx.height[v] + 1) {
+            Cap d = std::min(ctx.excess[u], residual);
+            if (ctx.excess[v] <= 0 && v != s && v != t) {
+                ctx.buckets[ctx.height[v]].push_back(v);
+                ctx.highest = std::max(ctx.highest, ctx.height[v]);
+            }
+            ctx.addFlow(a, d);
+            ctx.addFlow(reverse[a], -d);
+            ctx.excess[u] -= d;
+            ctx.excess[v] += d;
+            ctx.stats.pushes++;
+        } else {
+            ctx.current[u]++;
+        }
+    }
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::PushRelabel(int s, int t, BasicFlowContext<Cap> &ctx) const {
+    if (s == t) return 0;
+    int n = getNumVertices();
+    ctx.begin();
+    ctx.stats.computations++;
+    std::fill(ctx.excess.begin(), ctx.excess.end(), 0);
+
+    // Everything but the global relabels, which count as search, is time spent pushing flow
+    double searchBefore = ctx.stats.searchSeconds;
+    {
+        PhaseTimer timer(ctx.stats.augmentSeconds);
+        for (int a = first[s]; a < first[s + 1]; a++) {
+            Cap c = ctx.capacity[a] - ctx.getFlow(a);
+            if (c <= 0) continue;
+            ctx.addFlow(a, c);
+            ctx.addFlow(reverse[a], -c);
+            ctx.excess[s] -= c;
+            ctx.excess[head[a]] += c;
+        }
+        globalRelabel(s, t, ctx);
+        ctx.height[s] = n;
+
+        while (ctx.highest >= 0) {
+            auto &bucket = ctx.buckets[ctx.highest];
+            if (bucket.empty()) {
+                ctx.highest--;
+                continue;
+            }
+            int u = bucket.back();
+            bucket.pop_back();
+            if (ctx.height[u] != ctx.highest || ctx.excess[u] <= 0) continue; // stale entry
+            discharge(u, s, t, ctx);
+            if (ctx.relabels >= n) {
+                globalRelabel(s, t, ctx);
+            }
+        }
+    }
+    ctx.stats.augmentSeconds -= ctx.stats.searchSeconds - searchBefore;
+    return ctx.excess[t];
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::maxFlow(int s, int t, FlowAlgorithm algorithm, BasicFlowContext<Cap> &ctx) const {
+    switch (algorithm) {
+        case FlowAlgorithm::Dinic:
+            return Dinic(s, t, ctx);
+        case FlowAlgorithm::PushRelabel:
+            return PushRelabel(s, t, ctx);
+        case FlowAlgorithm::EdmondsKarp:
+        default:
+            return EdmondsKarp(s, t, ctx);
+    }
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::augmentMultiTerminal(const std::vector<std::pair<int, Cap>> &sources, BasicFlowContext<Cap> &ctx) const {
+    int found = -1;
+    {
+        PhaseTimer timer(ctx.stats.searchSeconds);
+        ctx.newSearch();
+        ctx.queue.clear();
+        for (const auto &source : sources) {
+            int v = source.first;
+            if (ctx.isVisited(v) || ctx.sourceBudget[v] <= 0) continue;
+            ctx.visit(v);
+            ctx.parentArc[v] = -1;
+            ctx.queue.push_back(v);
+        }
+
+        for (size_t q = 0; q < ctx.queue.size(); q++) {
+            int u = ctx.queue[q];
+            ctx.stats.verticesDequeued++;
+            if (ctx.sinkBudget[u] > 0) {
+                found = u;
+                break;
+            }
+            ctx.stats.edgesScanned += first[u + 1] - first[u];
+            for (int a = first[u]; a < first[u + 1]; a++) {
+                int v = head[a];
+                if (ctx.isVisited(v) || ctx.capacity[a] - ctx.getFlow(a) <= 0) continue;
+                ctx.visit(v);
+                ctx.parentArc[v] = a;
+                ctx.queue.push_back(v);
+            }
+        }
+    }
+    if (found == -1) return 0;
+
+    PhaseTimer timer(ctx.stats.augmentSeconds);
+
+    // The path starts and ends with a virtual arc, whose residual capacities are the budgets
+    Cap bottleNeck = ctx.sinkBudget[found];
+    int start = found;
+    for (; ctx.parentArc[start] != -1; start = head[reverse[ctx.parentArc[start]]]) {
+        int a = ctx.parentArc[start];
+        bottleNeck = std::min(bottleNeck, ctx.capacity[a] - ctx.getFlow(a));
+    }
+    bottleNeck = std::min(bottleNeck, ctx.sourceBudget[start]);
+    for (int v = found; ctx.parentArc[v] != -1; v = head[reverse[ctx.parentArc[v]]]) {
+        int a = ctx.parentArc[v];
+        ctx.addFlow(a, bottleNeck);
+        ctx.addFlow(reverse[a], -bottleNeck);
+    }
+    ctx.sourceBudget[start] -= bottleNeck;
+    ctx.sinkBudget[found] -= bottleNeck;
+    ctx.stats.recordPath(bottleNeck);
+    return bottleNeck;
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::multiTerminalMaxFlow(const std::vector<std::pair<int, Cap>> &sources, const std::vector<std::pair<int, Cap>> &sinks, BasicFlowContext<Cap> &ctx) const {
+    ctx.begin();
+    ctx.stats.computations++;
+    // Budgets saturate at the largest capacity, which stands for INF, so repeated terminals cannot overflow them
+    for (const auto &source : sources) {
+        ctx.sourceBudget[source.first] += std::min(std::numeric_limits<Cap>::max() - ctx.sourceBudget[source.first], source.second);
+    }
+    for (const auto &sink : sinks) {
+        ctx.sinkBudget[sink.first] += std::min(std::numeric_limits<Cap>::max() - ctx.sinkBudget[sink.first], sink.second);
+    }
+
+    Cap maxFlow = 0;
+    Cap f;
+    while ((f = augmentMultiTerminal(sources, ctx)) > 0) {
+        maxFlow += f;
+    }
+
+    // Remove the virtual arcs, so the budgets read 0 again for the next query
+    for (const auto &source : sources) {
+        ctx.sourceBudget[source.first] = 0;
+    }
+    for (const auto &sink : sinks) {
+        ctx.sinkBudget[sink.first] = 0;
+    }
+    return maxFlow;
+}
+
+template <class Cap>
+void BasicFlowNetwork<Cap>::minCut(int t, BasicFlowContext<Cap> &ctx, std::vector<bool> &sourceSide) const {
+    int n = getNumVertices();
+    sourceSide.assign(n, true);
+    ctx.queue.clear();
+    ctx.queue.push_back(t);
+    sourceSide[t] = false;
+    PhaseTimer timer(ctx.stats.searchSeconds);
+    for (size_t q = 0; q < ctx.queue.size(); q++) {
+        int u = ctx.queue[q];
+        ctx.stats.verticesDequeued++;
+        ctx.stats.edgesScanned += first[u + 1] - first[u];
+        for (int a = first[u]; a < first[u + 1]; a++) {
+            int v = head[a];
+            int r = reverse[a];
+            if (!sourceSide[v] || ctx.capacity[r] - ctx.getFlow(r) <= 0) continue;
+            sourceSide[v] = false;
+            ctx.queue.push_back(v);
+        }
+    }
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::pushFrom(int u, int a, int b, Cap limit, BasicFlowContext<Cap> &ctx) const {
+    ctx.newSearch();
+    ctx.queue.clear();
+    ctx.queue.push_back(u);
+    ctx.visit(u);
+    int found = -1;
+    for (size_t q = 0; q < ctx.queue.size() && found == -1; q++) {
+        int x = ctx.queue[q];
+        ctx.stats.verticesDequeued++;
+        ctx.stats.edgesScanned += first[x + 1] - first[x];
+        for (int arc = first[x]; arc < first[x + 1]; arc++) {
+            int y = head[arc];
+            if (ctx.isVisited(y) || ctx.capacity[arc] - ctx.getFlow(arc) <= 0) continue;
+            ctx.visit(y);
+            ctx.parentArc[y] = arc;
+            if (y == a || y == b) {
+                found = y;
+                break;
+            }
+            ctx.queue.push_back(y);
+        }
+    }
+    if (found == -1) return 0;
+
+    Cap bottleNeck = limit;
+    for (int y = found; y != u; y = head[reverse[ctx.parentArc[y]]]) {
+        int arc = ctx.parentArc[y];
+        bottleNeck = std::min(bottleNeck, ctx.capacity[arc] - ctx.getFlow(arc));
+    }
+    for (int y = found; y != u; y = head[reverse[ctx.parentArc[y]]]) {
+        int arc = ctx.parentArc[y];
+        ctx.addFlow(arc, bottleNeck);
+        ctx.addFlow(reverse[arc], -bottleNeck);
+    }
+    return bottleNeck;
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::pullInto(int v, int a, int b, Cap limit, BasicFlowContext<Cap> &ctx) const {
+    // Reverse BFS from v: parentArc[x] is the arc x -> y that brings x one step closer to v
+    ctx.newSearch();
+    ctx.queue.clear();
+    ctx.queue.push_back(v);
+    ctx.visit(v);
+    int found = -1;
+    for (size_t q = 0; q < ctx.queue.size() && found == -1; q++) {
+        int y = ctx.queue[q];
+        ctx.stats.verticesDequeued++;
+        ctx.stats.edgesScanned += first[y + 1] - first[y];
+        for (int arc = first[y]; arc < first[y + 1]; arc++) {
+            int x = head[arc];
+            int r = reverse[arc];
+            if (ctx.isVisited(x) || ctx.capacity[r] - ctx.getFlow(r) <= 0) continue;
+            ctx.visit(x);
+            ctx.parentArc[x] = r;
+            if (x == a || x == b) {
+                found = x;
+                break;
+            }
+            ctx.queue.push_back(x);
+        }
+    }
+    if (found == -1) return 0;
+
+    Cap bottleNeck = limit;
+    for (int x = found; x != v; x = head[ctx.parentArc[x]]) {
+        int arc = ctx.parentArc[x];
+        bottleNeck = std::min(bottleNeck, ctx.capacity[arc] - ctx.getFlow(arc));
+    }
+    for (int x = found; x != v; x = head[ctx.parentArc[x]]) {
+        int arc = ctx.parentArc[x];
+        ctx.addFlow(arc, bottleNeck);
+        ctx.addFlow(reverse[arc], -bottleNeck);
+    }
+    return bottleNeck;
+}
+
+template <class Cap>
+bool BasicFlowNetwork<Cap>::rebalance(int s, int t, const std::vector<int> &changedArcs, BasicFlowContext<Cap> &ctx) const {
+    PhaseTimer timer(ctx.stats.repairSeconds);
+    for (int a : changedArcs) {
+        Cap over = ctx.getFlow(a) - ctx.capacity[a];
+        if (over <= 0) continue;
+
+        // Cancel the excess: u keeps flow it can no longer send and v misses flow it was receiving
+        int u = head[reverse[a]];
+        int v = head[a];
+        ctx.addFlow(a, -over);
+        ctx.addFlow(reverse[a], over);
+
+        Cap stranded = over;
+        if (u == s || u == t || v == s || v == t) {
+            // A terminal absorbs the imbalance on its side, only the other side needs to be balanced
+            int side = (u == s || u == t) ? v : u;
+            while (stranded > 0 && side != s && side != t) {
+                Cap moved = side == v ? pullInto(v, s, t, stranded, ctx) : pushFrom(u, s, t, stranded, ctx);
+                if (moved <= 0) return false;
+                stranded -= moved;
+            }
+            continue;
+        }
+
+        Cap moved;
+        while (stranded > 0 && (moved = pushFrom(u, v, -1, stranded, ctx)) > 0) {
+            stranded -= moved;
+        }
+        for (Cap left = stranded; left > 0; left -= moved) {
+            moved = pushFrom(u, s, t, left, ctx);
+            if (moved <= 0) return false;
+        }
+        for (Cap left = stranded; left > 0; left -= moved) {
+            moved = pullInto(v, s, t, left, ctx);
+            if (moved <= 0) return false;
+        }
+    }
+    return true;
+}
+
+template <class Cap>
+Cap BasicFlowNetwork<Cap>::repairMaxFlow(int s, int t, const std::vector<int> &changedArcs, FlowAlgorithm algorithm, BasicFlowContext<Cap> &ctx) const {
+    if (s == t) return 0;
+    ctx.stats.repairs++;
+    if (!rebalance(s, t, changedArcs, ctx)) return maxFlow(s, t, algorithm, ctx);
+
+    augmentToMax(s, t, algorithm, ctx);
+    Cap value = 0;
+    for (int a = first[s]; a < first[s + 1]; a++) {
+        value += ctx.getFlow(a);
+    }
+    return value;
+}
+
+template class BasicFlowContext<int32_t>;
+template class BasicFlowContext<int64_t>;
+template class BasicFlowContext<double>;
+template class BasicFlowContextPool<int32_t>;
+template class BasicFlowContextPool<int64_t>;
+template class BasicFlowContextPool<double>;
+template class BasicFlowNetwork<int32_t>;
+template class BasicFlowNetwork<int64_t>;
+template class BasicFlowNetwork<double>;
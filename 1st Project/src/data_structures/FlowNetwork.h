@@ -0,0 +1,684 @@
+#ifndef G16_3_FLOWNETWORK_H
+#define G16_3_FLOWNETWORK_H
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "VertexEdge.h"
+#include "FlowStats.h"
+
+/**
+ * @brief Max-flow algorithms that can be selected for flow queries and reports.
+ */
+enum class FlowAlgorithm {
+    EdmondsKarp,
+    Dinic,
+    PushRelabel
+};
+
+/**
+ * @brief Converts a capacity to a capacity type, saturating at the limits of the type.
+ *
+ * Values too large for the type, INF included, become its largest value, which the solvers treat as unlimited. Integral types
+ * drop the fractional part.
+ *
+ * @tparam Cap The capacity type.
+ * @param value The capacity.
+ * @return The capacity as a Cap.
+ */
+template <class Cap>
+Cap toCapacity(double value) {
+    if (value >= (double) std::numeric_limits<Cap>::max()) return std::numeric_limits<Cap>::max();
+    if (value <= (double) std::numeric_limits<Cap>::lowest()) return std::numeric_limits<Cap>::lowest();
+    return (Cap) value;
+}
+
+/**
+ * @brief Checks if a capacity is held exactly by a capacity type.
+ *
+ * Loaders use it to reject capacities that toCapacity would change, such as fractional capacities on an integral type.
+ *
+ * @tparam Cap The capacity type.
+ * @param value The capacity.
+ * @return true if the capacity converts to Cap without loss, false otherwise.
+ */
+template <class Cap>
+bool isExactCapacity(double value) {
+    if (!std::numeric_limits<Cap>::is_integer) return true;
+    return value >= (double) std::numeric_limits<Cap>::lowest() && value <= (double) std::numeric_limits<Cap>::max() && value == (double) (Cap) value;
+}
+
+template <class Cap>
+class BasicFlowNetwork;
+
+/**
+ * @brief Per-query state of the max-flow algorithms: arc flows, visitation marks and the scratch arrays of every solver.
+ *
+ * A FlowNetwork only holds the topology and the capacities and is never written by the solvers. All writes go to a context,
+ * so any number of threads can run flow queries on the same network as long as each of them uses its own context.
+ * Flows and visitation marks are epoch-stamped: a value only counts when its stamp matches the current epoch, so begin()
+ * and newSearch() clear every flow or mark in O(1) by moving to a new epoch, instead of rewriting O(E) or O(V) entries.
+ *
+ * @tparam Cap The type of the capacities and flows, see BasicFlowNetwork.
+ */
+template <class Cap>
+class BasicFlowContext {
+public:
+    /**
+     * @brief Allocates a context sized for a network.
+     *
+     * @param network The network the context will be used with.
+     * Time Complexity: O(V + E)
+     */
+    explicit BasicFlowContext(const BasicFlowNetwork<Cap> &network);
+
+    /**
+     * @brief Starts a new query: every arc flow reads as 0 afterwards.
+     *
+     * Time Complexity: O(1), amortized over the 2^32 epochs after which the stamps are cleared
+     */
+    void begin();
+
+    /**
+     * @brief Gets the flow of an arc in the current query.
+     *
+     * @param a Index of the arc.
+     * @return The flow of the arc.
+     */
+    Cap getFlow(int a) const;
+
+    /**
+     * @brief Adds to the flow of an arc in the current query.
+     *
+     * @param a Index of the arc.
+     * @param delta The amount to add, negative to cancel flow.
+     */
+    void addFlow(int a, Cap delta);
+
+    /**
+     * @brief Replaces the arc capacities seen by the solvers that run on this context.
+     *
+     * The network itself is never changed, so a reduced or modified version of it can be evaluated on one context while other
+     * contexts keep using the original capacities. The current flow is kept, see FlowNetwork::repairMaxFlow.
+     *
+     * @param capacities One capacity per arc of the network, or nullptr to go back to the capacities of the network.
+     * The vector must stay alive and unchanged while it is in use.
+     */
+    void setCapacities(const std::vector<Cap> *capacities);
+
+    /**
+     * @brief Collects the arcs that carry flow in the current query.
+     *
+     * @param flows Output vector, filled with the index and flow of every arc whose flow is not 0.
+     * Time Complexity: O(E)
+     */
+    void saveFlows(std::vector<std::pair<int, Cap>> &flows) const;
+
+    /**
+     * @brief Starts a new query whose arc flows are those saved by saveFlows, so a computation can resume from them.
+     *
+     * @param flows The flows saved by saveFlows on a context of the same network.
+     * Time Complexity: O(number of saved arcs)
+     */
+    void loadFlows(const std::vector<std::pair<int, Cap>> &flows);
+
+    /**
+     * @brief Gets the work done by the solvers that ran on this context since it was created or last reset.
+     *
+     * @return The statistics of the context.
+     */
+    const FlowStats &getStats() const;
+
+    /**
+     * @brief Clears the statistics of the context, so the next ones cover only the calls made afterwards.
+     */
+    void resetStats();
+
+protected:
+    friend class BasicFlowNetwork<Cap>;
+
+    /**
+     * @brief Starts a new graph search: every vertex reads as unvisited afterwards.
+     *
+     * Time Complexity: O(1), amortized over the 2^32 searches after which the stamps are cleared
+     */
+    void newSearch();
+
+    /**
+     * @brief Checks if a vertex has been visited by the current search.
+     *
+     * @param v Index of the vertex.
+     * @return true if the vertex has been visited, false otherwise.
+     */
+    bool isVisited(int v) const;
+
+    /**
+     * @brief Marks a vertex as visited by the current search.
+     *
+     * @param v Index of the vertex.
+     */
+    void visit(int v);
+
+    /**
+     * @brief Checks if a vertex has been reached from the target by the current bidirectional search.
+     *
+     * @param v Index of the vertex.
+     * @return true if the vertex is in the target's search tree, false otherwise.
+     */
+    bool isVisitedFromSink(int v) const;
+
+    /**
+     * @brief Marks a vertex as reached from the target by the current bidirectional search.
+     *
+     * @param v Index of the vertex.
+     */
+    void visitFromSink(int v);
+
+    /**
+     * @brief Gets the level of a vertex in the current Dinic level graph.
+     *
+     * @param v Index of the vertex.
+     * @return The level of the vertex, -1 if it was not reached or has been pruned.
+     */
+    int levelOf(int v) const;
+
+    const Cap *capacity;            // capacities read by the solvers, those of the network unless replaced
+    const Cap *networkCapacity;
+
+    std::vector<Cap> flow;          // flow of each arc, valid when its stamp equals epoch
+    std::vector<unsigned> flowStamp;
+    unsigned epoch = 1;
+
+    std::vector<unsigned> visitStamp;   // a vertex is visited when its stamp equals searchEpoch
+    unsigned searchEpoch = 1;
+
+    std::vector<int> parentArc;     // BFS tree, valid for visited vertices
+    std::vector<int> queue;
+
+    std::vector<unsigned> sinkVisitStamp;   // a vertex is in the target's tree when its stamp equals searchEpoch
+    std::vector<int> childArc;              // arc from each vertex of the target's tree towards the target
+    std::vector<int> sinkQueue;
+
+    std::vector<int> level;         // BFS distance from the source in Dinic's level graph, valid for visited vertices, -1 when pruned
+    std::vector<int> current;       // current-arc pointer of each vertex in Dinic's blocking flow and in push-relabel
+    std::vector<int> pathArcs;      // arcs of the DFS path being extended
+
+    std::vector<int> height;                // push-relabel label, V for vertices that cannot reach the target
+    std::vector<Cap> excess;                // inflow minus outflow of each vertex
+    std::vector<int> heightCount;           // number of vertices with each height below V, used to detect gaps
+    std::vector<std::vector<int>> buckets;  // active vertices by height, entries may be stale
+    int highest = -1;                       // highest height that may hold an active vertex
+    int relabels = 0;                       // relabels since the last global relabel
+
+    std::vector<Cap> sourceBudget;          // residual capacity of the virtual arc from the super-source to each vertex, 0 outside a multi-terminal query
+    std::vector<Cap> sinkBudget;            // residual capacity of the virtual arc from each vertex to the super-sink, 0 outside a multi-terminal query
+
+    FlowStats stats;                        // work done by the solvers on this context
+};
+
+// The accessors below run in the innermost loops of every solver, so they are defined here to be inlined
+
+template <class Cap>
+inline Cap BasicFlowContext<Cap>::getFlow(int a) const {
+    return flowStamp[a] == epoch ? flow[a] : 0;
+}
+
+template <class Cap>
+inline void BasicFlowContext<Cap>::addFlow(int a, Cap delta) {
+    if (flowStamp[a] != epoch) {
+        flowStamp[a] = epoch;
+        flow[a] = delta;
+    } else {
+        flow[a] += delta;
+    }
+}
+
+template <class Cap>
+inline bool BasicFlowContext<Cap>::isVisited(int v) const {
+    return visitStamp[v] == searchEpoch;
+}
+
+template <class Cap>
+inline void BasicFlowContext<Cap>::visit(int v) {
+    visitStamp[v] = searchEpoch;
+}
+
+template <class Cap>
+inline bool BasicFlowContext<Cap>::isVisitedFromSink(int v) const {
+    return sinkVisitStamp[v] == searchEpoch;
+}
+
+template <class Cap>
+inline void BasicFlowContext<Cap>::visitFromSink(int v) {
+    sinkVisitStamp[v] = searchEpoch;
+}
+
+template <class Cap>
+inline int BasicFlowContext<Cap>::levelOf(int v) const {
+    return isVisited(v) ? level[v] : -1;
+}
+
+/**
+ * @brief Thread-safe pool of flow contexts for one network.
+ *
+ * Allocating a context costs O(V + E), so the single-query entry points of Graph borrow one from the pool and give it back
+ * when done. Concurrent queries each get their own context; the pool only grows up to the number of simultaneous queries.
+ *
+ * @tparam Cap The type of the capacities and flows, see BasicFlowNetwork.
+ */
+template <class Cap>
+class BasicFlowContextPool {
+public:
+    /**
+     * @brief Creates an empty pool for a network.
+     *
+     * @param network The network the contexts are sized for, kept alive by the pool.
+     */
+    explicit BasicFlowContextPool(std::shared_ptr<const BasicFlowNetwork<Cap>> network);
+
+    /**
+     * @brief Gets the network of the pool.
+     *
+     * @return A reference to the network.
+     */
+    const BasicFlowNetwork<Cap> &getNetwork() const;
+
+    /**
+     * @brief Takes a context from the pool, allocating a new one if every context is in use.
+     *
+     * @return The context, owned by the caller until it is released.
+     */
+    std::unique_ptr<BasicFlowContext<Cap>> acquire();
+
+    /**
+     * @brief Gives a context back to the pool.
+     *
+     * @param ctx The context, which must have been acquired from this pool.
+     */
+    void release(std::unique_ptr<BasicFlowContext<Cap>> ctx);
+
+protected:
+    std::shared_ptr<const BasicFlowNetwork<Cap>> network;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<BasicFlowContext<Cap>>> available;
+};
+
+/**
+ * @brief Flat compressed-sparse-row (CSR) residual graph used by the max-flow algorithms.
+ *
+ * The network is built once from the vertex set of a Graph. Vertices are indexed by their dense identifier (Vertex::getId)
+ * and every Edge becomes an arc.
+ * The arcs leaving vertex i are stored contiguously in the range [first[i], first[i + 1]) of the head, capacity and
+ * reverse arrays, so a BFS step walks one cache-friendly block instead of chasing Vertex and Edge pointers.
+ * Because the railway segments are bidirectional, the reverse of an arc is the arc of the opposite direction.
+ * The network is immutable once built; the flows of a computation live in the FlowContext passed to each solver.
+ *
+ * The capacities, flows and results are all of type Cap. The library is compiled for int32_t, int64_t and double: integral
+ * types give exact arithmetic and narrower arrays, int32_t halving the memory read by every residual check, while double
+ * accepts fractional capacities. Graph uses the type selected with G16_3_CAPACITY, see Capacity.
+ *
+ * @tparam Cap The type of the capacities and flows.
+ */
+template <class Cap>
+class BasicFlowNetwork {
+public:
+    /**
+     * @brief Builds the CSR arrays from a vertex set.
+     *
+     * @param vertexSet The vertices of the graph, each at the position given by its identifier.
+     * Time Complexity: O(V + E)
+     */
+    explicit BasicFlowNetwork(const std::vector<Vertex *> &vertexSet);
+
+    /**
+     * @brief Gets the number of vertices in the network.
+     *
+     * @return The number of vertices.
+     */
+    int getNumVertices() const;
+
+    /**
+     * @brief Gets the number of arcs in the network.
+     *
+     * @return The number of arcs.
+     */
+    int getNumArcs() const;
+
+    /**
+     * @brief Gets the dense index of a vertex, which is its identifier.
+     *
+     * @param v Pointer to the vertex.
+     * @return The index of the vertex, or -1 if it is not part of the network.
+     * Time Complexity: O(1)
+     */
+    int indexOf(const Vertex *v) const;
+
+    /**
+     * @brief Gets the vertex with a given dense index.
+     *
+     * @param i The index of the vertex.
+     * @return Pointer to the vertex.
+     */
+    Vertex *vertexAt(int i) const;
+
+    /**
+     * @brief Gets the index of the first arc leaving a vertex.
+     *
+     * @param u Index of the vertex.
+     * @return The index of the first arc of u; its arcs are [getArcsBegin(u), getArcsEnd(u)).
+     */
+    int getArcsBegin(int u) const;
+
+    /**
+     * @brief Gets the index one past the last arc leaving a vertex.
+     *
+     * @param u Index of the vertex.
+     * @return The index one past the last arc of u.
+     */
+    int getArcsEnd(int u) const;
+
+    /**
+     * @brief Gets the destination of an arc.
+     *
+     * @param a Index of the arc.
+     * @return Index of the vertex the arc enters.
+     */
+    int getHead(int a) const;
+
+    /**
+     * @brief Gets the opposite arc of an arc.
+     *
+     * @param a Index of the arc.
+     * @return Index of the arc in the other direction of the same segment.
+     */
+    int getReverse(int a) const;
+
+    /**
+     * @brief Gets the arc built from an edge.
+     *
+     * @param e Pointer to the edge.
+     * @return Index of the arc, or -1 if the edge is not part of the network.
+     * Time Complexity: O(deg(v)), with v the origin of the edge
+     */
+    int arcOf(const Edge *e) const;
+
+    /**
+     * @brief Gets the capacities of every arc.
+     *
+     * @return The capacities, indexed by arc.
+     */
+    const std::vector<Cap> &getCapacities() const;
+
+    /**
+     * @brief Computes the maximum flow between two vertices with the Edmonds-Karp algorithm.
+     *
+     * The flow array is reset before the computation, so every call is independent of the previous ones.
+     * Augmenting paths are found with a BFS over the CSR arrays, using an index queue and a parent-arc array
+     * that are reused between calls.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that receives the flow.
+     * @return The maximum flow from s to t.
+     * Time Complexity: O(VE^2)
+     */
+    Cap EdmondsKarp(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Computes the maximum flow between two vertices with Dinic's algorithm.
+     *
+     * Each phase builds a level graph with a BFS from the source and then saturates it with a blocking flow.
+     * The blocking flow is found with an iterative DFS that keeps a current-arc pointer per vertex, so every arc is
+     * discarded at most once per phase and vertices that cannot reach the target are pruned from the level graph.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that receives the flow.
+     * @return The maximum flow from s to t.
+     * Time Complexity: O(V^2 E)
+     */
+    Cap Dinic(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Computes the maximum flow between two vertices with the highest-label push-relabel algorithm.
+     *
+     * Active vertices are kept in buckets by height and the highest one is always discharged first. Two heuristics keep the
+     * heights close to the exact distances to the target: a global relabel (a reverse BFS from t) runs at the start and after
+     * every V relabels, and a gap relabel lifts every vertex above an emptied height to V, since none of them can reach t anymore.
+     * Only the first phase of the algorithm is run, so on return the flow array holds a maximum preflow: its value is exact, but
+     * vertices that cannot reach t may keep some excess.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that receives the flow.
+     * @return The maximum flow from s to t.
+     * Time Complexity: O(V^2 sqrt(E))
+     */
+    Cap PushRelabel(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Computes the maximum flow between two vertices with the selected algorithm.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param algorithm The max-flow algorithm to use.
+     * @param ctx The context that receives the flow.
+     * @return The maximum flow from s to t.
+     */
+    Cap maxFlow(int s, int t, FlowAlgorithm algorithm, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Computes the maximum flow from a set of sources to a set of sinks, each with its own capacity.
+     *
+     * The query behaves as if a super-source had an arc to every source and every sink had an arc to a super-sink, with the
+     * given capacities, but those virtual nodes only exist in the context: their arcs are the per-vertex budgets sourceBudget
+     * and sinkBudget, so the network is not modified and nothing is allocated. Augmenting paths are found with a
+     * multi-source BFS that starts from every source with budget left and stops at the nearest vertex with sink budget left,
+     * so this is Edmonds-Karp on the extended network.
+     *
+     * @param sources The source vertices and the capacity of their virtual arcs. A vertex may appear more than once.
+     * @param sinks The sink vertices and the capacity of their virtual arcs, the largest value of Cap for no limit. A vertex may appear more than once.
+     * @param ctx The context that receives the flow.
+     * @return The maximum flow from the sources to the sinks.
+     * Time Complexity: O(VE^2)
+     */
+    Cap multiTerminalMaxFlow(const std::vector<std::pair<int, Cap>> &sources, const std::vector<std::pair<int, Cap>> &sinks, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Extracts a minimum cut from the flow left by the last max-flow computation towards t.
+     *
+     * A vertex is on the target side when it can still reach t in the residual network, which is valid both after a full flow
+     * (Edmonds-Karp, Dinic) and after a maximum preflow (push-relabel). Every other vertex, including the source, is on the source side.
+     *
+     * @param t Index of the target vertex of the last computation.
+     * @param ctx The context that holds the flow of the last computation.
+     * @param sourceSide Output vector, set to true for the vertices on the source side of the cut.
+     * Time Complexity: O(V + E)
+     */
+    void minCut(int t, BasicFlowContext<Cap> &ctx, std::vector<bool> &sourceSide) const;
+
+    /**
+     * @brief Repairs a maximum flow after the capacities of some arcs have been lowered, instead of recomputing it from zero.
+     *
+     * The context must hold a maximum s-t flow (from EdmondsKarp or Dinic, or an earlier repair) and have had its capacities
+     * replaced with setCapacities since. For every changed arc whose flow now exceeds its capacity, only the excess flow is
+     * cancelled. The stranded flow is first rerouted around the arc, and whatever cannot be rerouted is returned along the
+     * residual network so that flow conservation holds again. The result is then augmented back to a maximum flow from
+     * that residual state. When only a few arcs change, most of the old flow stays in place and only a few augmenting
+     * paths are needed.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param changedArcs The arcs whose capacity has been lowered.
+     * @param algorithm The algorithm used to augment the repaired flow; push-relabel, which does not keep a flow, augments with Dinic.
+     * @param ctx The context that holds the flow.
+     * @return The maximum flow from s to t under the new capacities.
+     * Time Complexity: O(k (V + E)) to restore the flow, with k the number of paths moved, plus the augmentation
+     */
+    Cap repairMaxFlow(int s, int t, const std::vector<int> &changedArcs, FlowAlgorithm algorithm, BasicFlowContext<Cap> &ctx) const;
+
+protected:
+    /**
+     * @brief Finds a shortest augmenting path from s to t in the residual network and pushes its bottleneck.
+     *
+     * The search is bidirectional: one BFS grows from s along residual arcs and another grows from t against them, one whole
+     * level at a time, always on the side with the smaller frontier. It stops at the end of the first level in which the two
+     * trees touch, keeping the shortest of the paths joined there. On long railway lines this visits about the vertices
+     * within half the distance of s and t from either end, instead of every vertex closer to s than t is.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that holds the flow.
+     * @return The flow pushed along the path, or 0 if t is not reachable.
+     * Time Complexity: O(V + E)
+     */
+    Cap augment(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Builds the level graph of Dinic's algorithm with a BFS from s.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that holds the flow.
+     * @return true if t is reachable in the residual network, false otherwise.
+     * Time Complexity: O(V + E)
+     */
+    bool buildLevels(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Finds one s-t path in the level graph, advancing the current-arc pointers, and pushes its bottleneck.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that holds the flow.
+     * @return The flow pushed along the path, or 0 if the level graph is blocked.
+     */
+    Cap blockingPath(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Sets every height to the residual distance to t and rebuilds the buckets of active vertices.
+     *
+     * Vertices that cannot reach t get height V and are no longer discharged.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that holds the flow.
+     * Time Complexity: O(V + E)
+     */
+    void globalRelabel(int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Pushes the excess of a vertex through admissible arcs, relabeling it whenever its arcs are exhausted.
+     *
+     * @param u Index of the active vertex.
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param ctx The context that holds the flow.
+     */
+    void discharge(int u, int s, int t, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Lifts every vertex with a height in [h, V) to V after height h has become empty.
+     *
+     * @param h The height that no longer has any vertex.
+     * @param ctx The context that holds the labels.
+     * Time Complexity: O(V)
+     */
+    void gapRelabel(int h, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Augments the flow held by a context until it is a maximum s-t flow.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param algorithm EdmondsKarp for shortest augmenting paths, anything else for Dinic's blocking flows.
+     * @param ctx The context that holds the flow.
+     * @return The flow added.
+     */
+    Cap augmentToMax(int s, int t, FlowAlgorithm algorithm, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Finds a shortest augmenting path from any source to any sink with budget left and pushes its bottleneck.
+     *
+     * @param sources The source vertices of the query.
+     * @param ctx The context that holds the flow and the budgets.
+     * @return The flow pushed along the path, or 0 if no sink is reachable.
+     * Time Complexity: O(V + E)
+     */
+    Cap augmentMultiTerminal(const std::vector<std::pair<int, Cap>> &sources, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Pushes flow from a vertex to the nearest of two vertices along one shortest residual path.
+     *
+     * @param u Index of the vertex the flow leaves.
+     * @param a Index of the first vertex that can receive it.
+     * @param b Index of the second vertex that can receive it, or -1.
+     * @param limit The most flow to push.
+     * @param ctx The context that holds the flow.
+     * @return The flow pushed, 0 if neither vertex is reachable.
+     * Time Complexity: O(V + E)
+     */
+    Cap pushFrom(int u, int a, int b, Cap limit, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Pulls flow into a vertex from the nearest of two vertices along one shortest residual path.
+     *
+     * @param v Index of the vertex the flow enters.
+     * @param a Index of the first vertex that can send it.
+     * @param b Index of the second vertex that can send it, or -1.
+     * @param limit The most flow to pull.
+     * @param ctx The context that holds the flow.
+     * @return The flow pulled, 0 if v is not reachable from either vertex.
+     * Time Complexity: O(V + E)
+     */
+    Cap pullInto(int v, int a, int b, Cap limit, BasicFlowContext<Cap> &ctx) const;
+
+    /**
+     * @brief Removes the flow that exceeds the new capacity of the changed arcs and routes it again, keeping a valid flow.
+     *
+     * The flow stranded on each side of a reduced arc is first sent around it, then returned to the terminals with pushFrom
+     * and pullInto. This is the first step of repairMaxFlow.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @param changedArcs The arcs whose capacity changed.
+     * @param ctx The context that holds the flow and the new capacities.
+     * @return true if the flow was rebalanced, false if some stranded flow could not be routed and the flow must be recomputed.
+     */
+    bool rebalance(int s, int t, const std::vector<int> &changedArcs, BasicFlowContext<Cap> &ctx) const;
+
+    std::vector<int> first;         // arcs of vertex i are [first[i], first[i + 1])
+    std::vector<int> head;          // destination of each arc
+    std::vector<Cap> capacity;      // capacity of each arc
+    std::vector<int> reverse;       // index of the opposite arc
+    std::vector<const Edge *> edges;    // edge of each arc, nullptr for the added zero capacity arcs
+
+    std::vector<Vertex *> vertices;
+};
+
+extern template class BasicFlowContext<int32_t>;
+extern template class BasicFlowContext<int64_t>;
+extern template class BasicFlowContext<double>;
+extern template class BasicFlowContextPool<int32_t>;
+extern template class BasicFlowContextPool<int64_t>;
+extern template class BasicFlowContextPool<double>;
+extern template class BasicFlowNetwork<int32_t>;
+extern template class BasicFlowNetwork<int64_t>;
+extern template class BasicFlowNetwork<double>;
+
+// Set by CMake from the G16_3_CAPACITY cache variable: int32_t, int64_t or double
+#ifndef G16_3_CAPACITY
+#define G16_3_CAPACITY int64_t
+#endif
+
+/**
+ * @brief Type of the capacities and flows of the networks built by Graph, chosen when the project is configured.
+ */
+typedef G16_3_CAPACITY Capacity;
+
+typedef BasicFlowContext<Capacity> FlowContext;
+typedef BasicFlowContextPool<Capacity> FlowContextPool;
+typedef BasicFlowNetwork<Capacity> FlowNetwork;
+
+#endif //G16_3_FLOWNETWORK_H
@@ -0,0 +1,50 @@
+#include "FlowStats.h"
+
+void FlowStats::recordPath(double bottleNeck) {
+    augmentingPaths++;
+    int bin = 0;
+    for (double limit = 1.0; bin < BOTTLENECK_BINS - 1 && bottleNeck >= limit; limit *= 2.0) {
+        bin++;
+    }
+    bottlenecks[bin]++;
+}
+
+void FlowStats::merge(const FlowStats &other) {
+    computations += other.computations;
+    repairs += other.repairs;
+    augmentingPaths += other.augmentingPaths;
+    verticesDequeued += other.verticesDequeued;
+    edgesScanned += other.edgesScanned;
+    pushes += other.pushes;
+    relabels += other.relabels;
+    for (int i = 0; i < BOTTLENECK_BINS; i++) {
+        bottlenecks[i] += other.bottlenecks[i];
+    }
+    searchSeconds += other.searchSeconds;
+    augmentSeconds += other.augmentSeconds;
+    repairSeconds += other.repairSeconds;
+}
+
+void FlowStats::dump(std::ostream &out) const {
+    out << "{\"computations\":" << computations << ",\"repairs\":" << repairs
+        << ",\"augmenting_paths\":" << augmentingPaths << ",\"vertices_dequeued\":" << verticesDequeued
+        << ",\"edges_scanned\":" << edgesScanned << ",\"pushes\":" << pushes << ",\"relabels\":" << relabels
+        << ",\"bottlenecks\":{";
+    double low = 0.0;
+    for (int i = 0; i < BOTTLENECK_BINS; i++) {
+        double high = i == 0 ? 1.0 : low * 2.0;
+        out << (i == 0 ? "" : ",") << "\"" << low;
+        if (i + 1 < BOTTLENECK_BINS) {
+            out << "-" << high << "\":";
+        } else {
+            out << "+\":";
+        }
+        out << bottlenecks[i];
+        low = high;
+    }
+    out << "},\"phase_timing\":" << (PHASE_TIMING ? "true" : "false");
+    if (PHASE_TIMING) {
+        out << ",\"search_s\":" << searchSeconds << ",\"augment_s\":" << augmentSeconds << ",\"repair_s\":" << repairSeconds;
+    }
+    out << "}";
+}
@@ -0,0 +1,99 @@
+#ifndef G16_3_FLOWSTATS_H
+#define G16_3_FLOWSTATS_H
+#include <chrono>
+#include <ostream>
+
+// Set by CMake from the G16_3_PHASE_TIMING option
+#ifdef G16_3_PHASE_TIMING
+const bool PHASE_TIMING = true;
+#else
+const bool PHASE_TIMING = false;   // the solvers then read no clock, not even once per augmenting path
+#endif
+
+/**
+ * @brief Work done by the max-flow solvers, accumulated over any number of computations.
+ *
+ * Every FlowContext keeps one, updated by the solvers that run on it, so statistics can be read per call or merged across
+ * threads and reports. Time is split in phases: searching for augmenting paths or labels (the BFS of Edmonds-Karp, the level
+ * graph of Dinic, the global relabel of push-relabel), pushing flow (path updates, blocking-flow DFS, discharges) and
+ * rebalancing a repaired flow. The bottleneck of every augmenting path is recorded in a histogram with power-of-two bins.
+ * The counters are always kept; the phase times stay at 0 unless phase timing is enabled, see PHASE_TIMING.
+ */
+struct FlowStats {
+    static const int BOTTLENECK_BINS = 8;      // bins [0, 1), [1, 2), [2, 4), ..., [64, +inf)
+
+    unsigned long computations = 0;            // max-flow computations started from an empty flow
+    unsigned long repairs = 0;                 // max flows repaired after a change of capacities
+    unsigned long augmentingPaths = 0;
+    unsigned long verticesDequeued = 0;        // vertices taken from the queue of a BFS
+    unsigned long edgesScanned = 0;            // residual arcs examined by searches, DFS and discharges
+    unsigned long pushes = 0;                  // push-relabel pushes
+    unsigned long relabels = 0;                // push-relabel relabels
+    unsigned long bottlenecks[BOTTLENECK_BINS] = {};   // augmenting paths by bottleneck
+    double searchSeconds = 0.0;
+    double augmentSeconds = 0.0;
+    double repairSeconds = 0.0;
+
+    /**
+     * @brief Records an augmenting path.
+     *
+     * @param bottleNeck The flow pushed along the path.
+     */
+    void recordPath(double bottleNeck);
+
+    /**
+     * @brief Adds the counters and times of other statistics to these.
+     *
+     * @param other The statistics to add.
+     */
+    void merge(const FlowStats &other);
+
+    /**
+     * @brief Writes the statistics as a single-line JSON object.
+     *
+     * The phase times are written only when phase timing is enabled, as "phase_timing" says, so a build that does not
+     * measure them does not report them as 0.
+     *
+     * @param out The stream the statistics are written to.
+     */
+    void dump(std::ostream &out) const;
+};
+
+/**
+ * @brief Adds the wall time of its own lifetime to a phase of a FlowStats, when PHASE_TIMING is set.
+ *
+ * Without PHASE_TIMING it does nothing, so timers placed in the inner loops of the solvers cost nothing by default.
+ */
+class PhaseTimer {
+public:
+    /**
+     * @brief Starts timing.
+     *
+     * @param seconds The phase time that receives the elapsed time.
+     */
+    explicit PhaseTimer(double &seconds);
+
+    /**
+     * @brief Stops timing and adds the elapsed time to the phase.
+     */
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+protected:
+    double &seconds;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Timers run once or twice per augmenting path, so they are defined here to be inlined, and removed when disabled
+
+inline PhaseTimer::PhaseTimer(double &seconds): seconds(seconds) {
+    if (PHASE_TIMING) start = std::chrono::steady_clock::now();
+}
+
+inline PhaseTimer::~PhaseTimer() {
+    if (PHASE_TIMING) seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+#endif //G16_3_FLOWSTATS_H
@@ -0,0 +1,81 @@
+#include "GomoryHuTree.h"
+
+GomoryHuTree::GomoryHuTree(const FlowNetwork &network, FlowAlgorithm algorithm, const Scenario *scenario) {
+    int n = network.getNumVertices();
+    parent.assign(n, 0);
+    weight.assign(n, 0.0);
+    if (n == 0) return;
+    parent[0] = -1;
+
+    FlowContext ctx(network);
+    ctx.setCapacities(scenario == nullptr ? nullptr : scenario->getCapacities());
+    std::vector<bool> sourceSide;
+    for (int i = 1; i < n; i++) {
+        int t = parent[i];
+        weight[i] = network.maxFlow(i, t, algorithm, ctx);
+        network.minCut(t, ctx, sourceSide);
+        for (int j = i + 1; j < n; j++) {
+            if (parent[j] == t && sourceSide[j]) {
+                parent[j] = i;
+            }
+        }
+    }
+
+    stats = ctx.getStats();
+
+    // Parents always have smaller indices, so depths can be filled in index order
+    depth.assign(n, 0);
+    children.assign(n, {});
+    for (int i = 1; i < n; i++) {
+        depth[i] = depth[parent[i]] + 1;
+        children[parent[i]].push_back(i);
+    }
+}
+
+const FlowStats &GomoryHuTree::getStats() const {
+    return stats;
+}
+
+int GomoryHuTree::getNumVertices() const {
+    return (int) parent.size();
+}
+
+double GomoryHuTree::maxFlow(int u, int v) const {
+    if (u == v) return 0.0;
+    double result = std::numeric_limits<double>::max();
+    while (u != v) {
+        if (depth[u] < depth[v]) std::swap(u, v);
+        result = std::min(result, weight[u]);
+        u = parent[u];
+    }
+    return result;
+}
+
+void GomoryHuTree::flowsFrom(int u, std::vector<double> &flows) const {
+    int n = getNumVertices();
+    flows.assign(n, 0.0);
+    if (n == 0) return;
+
+    // DFS over the tree from u, carrying the smallest weight seen on the path
+    std::vector<bool> seen(n, false);
+    std::vector<int> stack = {u};
+    seen[u] = true;
+    flows[u] = std::numeric_limits<double>::max();
+    while (!stack.empty()) {
+        int x = stack.back();
+        stack.pop_back();
+        for (int y : children[x]) {
+            if (seen[y]) continue;
+            seen[y] = true;
+            flows[y] = std::min(flows[x], weight[y]);
+            stack.push_back(y);
+        }
+        int p = parent[x];
+        if (p != -1 && !seen[p]) {
+            seen[p] = true;
+            flows[p] = std::min(flows[x], weight[x]);
+            stack.push_back(p);
+        }
+    }
+    flows[u] = 0.0;
+}
@@ -0,0 +1,71 @@
+#ifndef G16_3_GOMORYHUTREE_H
+#define G16_3_GOMORYHUTREE_H
+#include <vector>
+#include "FlowNetwork.h"
+#include "Scenario.h"
+
+/**
+ * @brief Flow-equivalent Gomory-Hu tree of an undirected network, built with Gusfield's algorithm.
+ *
+ * The tree has one node per vertex of the network and is rooted at vertex 0. For any two vertices, the maximum flow between them
+ * equals the smallest edge weight on the tree path that connects them, so all V(V-1)/2 pairwise flows are answered after only V-1
+ * max-flow computations. Gusfield's algorithm needs no graph contraction, each step is a max-flow on the original network.
+ */
+class GomoryHuTree {
+public:
+    /**
+     * @brief Builds the tree of a network.
+     *
+     * Vertex i (i >= 1) starts attached to vertex 0. Step i computes a minimum cut between i and its current parent, records the
+     * cut value as the weight of the edge to the parent, and re-attaches to i every later vertex that shares the parent and falls
+     * on i's side of the cut.
+     *
+     * @param network The residual network.
+     * @param algorithm The max-flow algorithm used for the V-1 cuts.
+     * @param scenario Scenario whose capacities replace those of the network, or nullptr.
+     * Time Complexity: O(V) max-flow computations
+     */
+    GomoryHuTree(const FlowNetwork &network, FlowAlgorithm algorithm, const Scenario *scenario = nullptr);
+
+    /**
+     * @brief Gets the number of vertices in the tree.
+     *
+     * @return The number of vertices.
+     */
+    int getNumVertices() const;
+
+    /**
+     * @brief Gets the maximum flow between two vertices as the minimum edge weight on their tree path.
+     *
+     * @param u Index of one vertex.
+     * @param v Index of the other vertex.
+     * @return The maximum flow between u and v, or 0 if u == v.
+     * Time Complexity: O(V)
+     */
+    double maxFlow(int u, int v) const;
+
+    /**
+     * @brief Gets the work done by the max-flow solvers while building the tree.
+     *
+     * @return The statistics of the V-1 max-flow computations.
+     */
+    const FlowStats &getStats() const;
+
+    /**
+     * @brief Gets the maximum flow from one vertex to every other vertex.
+     *
+     * @param u Index of the vertex.
+     * @param flows Output vector, flows[v] is set to the maximum flow between u and v (0 for v == u).
+     * Time Complexity: O(V)
+     */
+    void flowsFrom(int u, std::vector<double> &flows) const;
+
+protected:
+    std::vector<int> parent;                // parent of each vertex, -1 for the root
+    std::vector<double> weight;             // weight of the edge from each vertex to its parent
+    std::vector<int> depth;                 // distance to the root
+    std::vector<std::vector<int>> children; // tree adjacency towards the leaves
+    FlowStats stats;                        // work of the V-1 max-flow computations
+};
+
+#endif //G16_3_GOMORYHUTREE_H
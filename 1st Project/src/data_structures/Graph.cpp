@@ -1,102 +1,217 @@
+#include <stdexcept>
 #include <unordered_set>
 #include "Graph.h"
 
-std::vector<Vertex *> Graph::getVertexSet() const {
+Graph::Graph(const Graph &other): storage(other.storage), vertexArena(other.vertexArena), vertexSet(other.vertexSet), nameIndex(other.nameIndex), serviceCosts(other.serviceCosts), costEpoch(other.costEpoch.load()) {}
+
+StringTable &Graph::getStrings() {
+    return storage->strings;
+}
+
+const std::vector<Vertex *> &Graph::getVertexSet() const {
     return vertexSet;
 }
 
+unsigned long Graph::getVersion() const {
+    return storage->version.load();
+}
+
+ResultCache &Graph::getResultCache() {
+    return resultCache;
+}
+
+FlowStats Graph::getFlowStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return flowStats;
+}
+
+void Graph::resetFlowStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    flowStats = FlowStats();
+}
+
+void Graph::recordStats(const FlowStats &stats) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    flowStats.merge(stats);
+}
+
+void Graph::recordStats(FlowContext &ctx) {
+    recordStats(ctx.getStats());
+    ctx.resetStats();
+}
+
+void Graph::clearCaches() {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    network = nullptr;
+    contextPool = nullptr;
+    gomoryHuTree = nullptr;
+    pairFlows = nullptr;
+    minCostNetwork = nullptr;
+    resultCache.clear();
+}
+
 bool Graph::removeVertex(const std::string& station_name) {
     Vertex* v = findVertex(station_name);
     if (v == nullptr) {
         return false;
     }
 
-    for (auto e : v->getAdj()) {
-        auto w = e->getDest();
-        w->removeEdge(v->getName());
-        v->removeEdge(w->getName());
+    // removeEdge shrinks the adjacency list, so the last edge is taken until none is left
+    while (!v->getAdj().empty()) {
+        auto w = v->getAdj().back()->getDest();
+        w->removeEdge(v);
+        v->removeEdge(w);
     }
 
-    for (auto it = vertexSet.begin(); it != vertexSet.end(); it++) {
-        if ((*it)->getName() == station_name){
-            vertexSet.erase(it);
-            break;
-        }
+    int id = v->getId();
+    vertexSet.erase(vertexSet.begin() + id);
+    nameIndex.erase(station_name);
+    for (int i = id; i < (int) vertexSet.size(); i++) {
+        vertexSet[i]->setId(i);
+        nameIndex[vertexSet[i]->getName()] = i;
     }
 
-    delete v;
+    vertexArena->destroy(v);
+    storage->version++;
     return true;
 }
 
-Vertex * Graph::findVertex(const std::string &name) const {
-    for (auto v : vertexSet)
-        if (v->getName() == name)
-            return v;
-    return nullptr;
+bool Graph::removeEdge(const std::string &origName, const std::string &destName) {
+    Vertex *orig = findVertex(origName);
+    Vertex *dest = findVertex(destName);
+    if (orig == nullptr || dest == nullptr) {
+        return false;
+    }
+    bool removed = orig->removeEdge(dest);
+    removed = dest->removeEdge(orig) || removed;
+    if (removed) storage->version++;
+    return removed;
 }
 
-bool Graph::addVertex(Vertex* vertex) {
+Vertex * Graph::findVertex(std::string_view name) const {
+    auto it = nameIndex.find(name);
+    if (it == nameIndex.end())
+        return nullptr;
+    return vertexSet[it->second];
+}
+
+Vertex *Graph::addVertex(const std::string &name, const std::string &district, const std::string &municipality, const std::string &township, const std::string &line) {
+    StringTable &strings = storage->strings;
+    return addVertex(strings.intern(name), strings.intern(district), strings.intern(municipality), strings.intern(township), strings.intern(line));
+}
+
+Vertex *Graph::addVertex(uint32_t name, uint32_t district, uint32_t municipality, uint32_t township, uint32_t line) {
+    if (!nameIndex.emplace(storage->strings.at(name), (int) vertexSet.size()).second)
+        return nullptr;
+    Vertex *vertex = vertexArena->create(name, district, municipality, township, line, *storage);
+    vertex->setId((int) vertexSet.size());
     vertexSet.push_back(vertex);
+    storage->version++;
+    return vertex;
 }
 
 bool Graph::addBidirectionalEdge(Vertex* v1,Vertex* v2, double w,std::string service) {
+    return addBidirectionalEdge(v1, v2, w, storage->strings.intern(service));
+}
+
+bool Graph::addBidirectionalEdge(Vertex* v1,Vertex* v2, double w,uint32_t service) {
     if (v1 == nullptr || v2 == nullptr)
         return false;
     auto e1 = v1->addEdge(v2, w,service);
     auto e2 = v2->addEdge(v1, w,service);
     e1->setReverse(e2);
     e2->setReverse(e1);
+    storage->version++;
     return true;
 }
 
-void Graph::MaxFlowBetweenPairs() {
-    auto start = std::chrono::high_resolution_clock::now();
-    double maxflow = -1;
-    std::vector<std::pair<Vertex *, Vertex *>> result;
+const FlowNetwork &Graph::getFlowNetwork() {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    if (network == nullptr || networkVersion != getVersion()) {
+        network = std::make_shared<FlowNetwork>(vertexSet);
+        contextPool = std::make_shared<FlowContextPool>(network);
+        networkVersion = getVersion();
+    }
+    return *network;
+}
 
-    for (int i = 0; i < vertexSet.size(); i++) {
-        for (int j = i + 1; j < vertexSet.size(); j++) {
-            Vertex *s = vertexSet[i];
-            Vertex *t = vertexSet[j];
-            double m = EdmondsKarp(s, t);
+std::shared_ptr<FlowContextPool> Graph::getContextPool() {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    getFlowNetwork();
+    return contextPool;
+}
 
+void Graph::MaxFlowBetweenPairs(FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    const FlowNetwork &net = getFlowNetwork();
+    const PairFlowMatrix &flows = getPairFlows(algorithm, method, threads);
+    int n = flows.getNumVertices();
+    double maxflow = -1;
+    std::vector<std::pair<int, int>> result;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            double m = flows.get(i, j);
             if (m > maxflow) {
                 maxflow = m;
                 result.clear();
-                result.emplace_back(s, t);
+                result.emplace_back(i, j);
             } else if (m == maxflow) {
-                result.emplace_back(s, t);
+                result.emplace_back(i, j);
             }
         }
     }
 
     for (const auto &pair : result) {
-        std::cout << pair.first->getName() << " / " << pair.second->getName() << std::endl;
+        std::cout << net.vertexAt(pair.first)->getName() << " / " << net.vertexAt(pair.second)->getName() << std::endl;
     }
-    auto end = std::chrono::high_resolution_clock::now(); // Fim do temporizador
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    std::cout << "Tempo de execução: " << duration << "ms" << std::endl;
 }
 
-void Graph::topDistricts(int k){
-    std::map<std::string, double> districtMaxFlows;
+std::vector<std::pair<std::string, double>> Graph::rankGroups(const std::function<uint32_t(const Vertex *)> &groupOf, FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    const FlowNetwork &net = getFlowNetwork();
+    const PairFlowMatrix &flows = getPairFlows(algorithm, method, threads);
+    int n = flows.getNumVertices();
+
+    std::vector<uint32_t> groups(n);
+    std::vector<bool> present(storage->strings.size(), false);
+    for (int i = 0; i < n; i++) {
+        groups[i] = groupOf(net.vertexAt(i));
+        present[groups[i]] = true;
+    }
 
-    for (int i = 0; i < vertexSet.size(); i++) {
-        for (int j = i + 1; j < vertexSet.size(); j++) {
-            Vertex *s = vertexSet[i];
-            Vertex *t = vertexSet[j];
-            if(s->getDistrict() != t->getDistrict()){ // Verificar se os distritos são diferentes
-                double maxFlow = EdmondsKarp(s, t);
-                districtMaxFlows[s->getDistrict()] += maxFlow;
-                districtMaxFlows[t->getDistrict()] += maxFlow;
+    // Groups are compared and accumulated by their code, the names are only looked up for the result
+    std::vector<double> groupMaxFlows(storage->strings.size(), 0.0);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (groups[i] != groups[j]) {
+                double maxFlow = flows.get(i, j);
+                groupMaxFlows[groups[i]] += maxFlow;
+                groupMaxFlows[groups[j]] += maxFlow;
             }
         }
     }
 
-    std::vector<std::pair<std::string, double>> sortedDistricts(districtMaxFlows.begin(), districtMaxFlows.end());
-    std::sort(sortedDistricts.begin(), sortedDistricts.end(), [](const std::pair<std::string, double>& left, const std::pair<std::string, double>& right) {
-        return left.second > right.second;
+    std::vector<std::pair<std::string, double>> sortedGroups;
+    for (uint32_t code = 0; code < present.size(); code++) {
+        if (present[code]) sortedGroups.emplace_back(storage->strings.at(code), groupMaxFlows[code]);
+    }
+    // Decreasing flow, ties ordered by name so the ranking is the same on every run and standard library
+    std::sort(sortedGroups.begin(), sortedGroups.end(), [](const std::pair<std::string, double>& left, const std::pair<std::string, double>& right) {
+        if (left.second != right.second) return left.second > right.second;
+        return left.first < right.first;
     });
+    return sortedGroups;
+}
+
+std::vector<std::pair<std::string, double>> Graph::rankDistricts(FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    return rankGroups([](const Vertex *v) { return v->getDistrictCode(); }, algorithm, method, threads);
+}
+
+std::vector<std::pair<std::string, double>> Graph::rankMunicipalities(FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    return rankGroups([](const Vertex *v) { return v->getMunicipalityCode(); }, algorithm, method, threads);
+}
+
+void Graph::topDistricts(int k, FlowAlgorithm algorithm, PairsMethod method, unsigned threads){
+    std::vector<std::pair<std::string, double>> sortedDistricts = rankDistricts(algorithm, method, threads);
 
     // Print top districts
     std::cout << "Top districts: \n";
@@ -106,25 +221,8 @@ void Graph::topDistricts(int k){
 }
 
 
-void Graph::topMunicipalities(int k) {
-    std::map<std::string, double> municipalitiesMaxFlows;
-
-    for (int i = 0; i < vertexSet.size(); i++) {
-        for (int j = i + 1; j < vertexSet.size(); j++) {
-            Vertex *s = vertexSet[i];
-            Vertex *t = vertexSet[j];
-            if(s->getMunicipality() != t->getMunicipality()){ // Verificar se os municípios são diferentes
-                double maxFlow = EdmondsKarp(s, t);
-                municipalitiesMaxFlows[s->getMunicipality()] += maxFlow;
-                municipalitiesMaxFlows[t->getMunicipality()] += maxFlow;
-            }
-        }
-    }
-
-    std::vector<std::pair<std::string, double>> sortedMunicipalities(municipalitiesMaxFlows.begin(), municipalitiesMaxFlows.end());
-    std::sort(sortedMunicipalities.begin(), sortedMunicipalities.end(), [](const std::pair<std::string, double>& left, const std::pair<std::string, double>& right) {
-        return left.second > right.second;
-    });
+void Graph::topMunicipalities(int k, FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    std::vector<std::pair<std::string, double>> sortedMunicipalities = rankMunicipalities(algorithm, method, threads);
 
     std::cout << "Top municipalities: \n";
     for (int i = 0; i < k && i < sortedMunicipalities.size(); i++) { // Verificar o índice para evitar acessar um índice fora do limite
@@ -133,76 +231,256 @@ void Graph::topMunicipalities(int k) {
 }
 
 void Graph::maxTrainsAtStation(Vertex *station) {
-    // Adiciona um nó source ao grafo
-    Vertex *source = new Vertex("Source");
-    addVertex(source);
-
-    // Conecta o nó source a todos os vértices adjacentes à estação
-    for (Edge *edge : station->getAdj()) {
-        Vertex *adjacentVertex = edge->getDest();
-            addBidirectionalEdge(source, adjacentVertex, edge->getWeight(),"-");
-        }
-
-    // Executa o algoritmo de fluxo máximo para obter o número máximo
-    double maxFlow = EdmondsKarp(source, station);
+    double maxFlow = getMaxTrainsAtStation(station);
     std::cout << "Maximum number of trains that can simultaneously arrive at station " << station->getName() << ": " << maxFlow << std::endl;
+}
+
+double Graph::getMaxTrainsAtStation(Vertex *station) {
+    ResultKey key = {nullptr, station, CachedQuery::MaxTrainsAtStation, getVersion()};
+    std::pair<double, double> result;
+    if (resultCache.lookup(key, result)) return result.first;
+
+    std::shared_ptr<FlowContextPool> pool = getContextPool();
+    const FlowNetwork &net = pool->getNetwork();
+    int t = net.indexOf(station);
+    if (t == -1) return 0.0;
+
+    // Cada vértice adjacente à estação recebe do super-source a capacidade do segmento que o liga à estação
+    std::vector<std::pair<int, Capacity>> sources;
+    const std::vector<Capacity> &capacities = net.getCapacities();
+    for (int a = net.getArcsBegin(t); a < net.getArcsEnd(t); a++) {
+        if (capacities[a] > 0) sources.emplace_back(net.getHead(a), capacities[a]);
+    }
+    std::vector<std::pair<int, Capacity>> sinks = {{t, toCapacity<Capacity>(INF)}};
 
-    // Remove o nó source e as arestas adicionadas ao grafo
-    removeVertex(source->getName());
+    std::unique_ptr<FlowContext> ctx = pool->acquire();
+    double maxFlow = net.multiTerminalMaxFlow(sources, sinks, *ctx);
+    recordStats(*ctx);
+    pool->release(std::move(ctx));
+    resultCache.insert(key, {maxFlow, 0.0});
+    return maxFlow;
+}
+
+double Graph::maxFlow(const std::vector<std::pair<Vertex *, double>> &sources, const std::vector<std::pair<Vertex *, double>> &sinks) {
+    std::shared_ptr<FlowContextPool> pool = getContextPool();
+    const FlowNetwork &net = pool->getNetwork();
+    std::vector<std::pair<int, Capacity>> sourceIndices;
+    std::vector<std::pair<int, Capacity>> sinkIndices;
+    for (const auto &source : sources) {
+        int v = net.indexOf(source.first);
+        if (v != -1) sourceIndices.emplace_back(v, toCapacity<Capacity>(source.second));
+    }
+    for (const auto &sink : sinks) {
+        int v = net.indexOf(sink.first);
+        if (v != -1) sinkIndices.emplace_back(v, toCapacity<Capacity>(sink.second));
+    }
+    if (sourceIndices.empty() || sinkIndices.empty()) return 0.0;
+
+    std::unique_ptr<FlowContext> ctx = pool->acquire();
+    double flow = net.multiTerminalMaxFlow(sourceIndices, sinkIndices, *ctx);
+    recordStats(*ctx);
+    pool->release(std::move(ctx));
+    return flow;
+}
+
+std::pair<double, double> Graph::minCostTrains(Vertex *source, Vertex *destination) {
+    ResultKey key = {source, destination, CachedQuery::MinCost, getVersion(), costEpoch.load()};
+    std::pair<double, double> result;
+    if (resultCache.lookup(key, result)) return result;
+
+    std::shared_ptr<const MinCostFlowNetwork> net = getMinCostNetwork();
+    int s = net->indexOf(source);
+    int t = net->indexOf(destination);
+    if (s == -1 || t == -1) return {0.0, 0.0};
+    result = net->minCostMaxFlow(s, t);
+    resultCache.insert(key, result);
+    return result;
+}
+
+void Graph::setServiceCost(const std::string &service, double cost) {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    serviceCosts[service] = cost;
+    costEpoch++;
+}
+
+std::shared_ptr<const MinCostFlowNetwork> Graph::getMinCostNetwork() {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    if (minCostNetwork == nullptr || minCostVersion != getVersion() || minCostEpoch != costEpoch) {
+        minCostNetwork = std::make_shared<MinCostFlowNetwork>(vertexSet, serviceCosts);
+        minCostVersion = getVersion();
+        minCostEpoch = costEpoch;
+    }
+    return minCostNetwork;
 }
 
 double Graph::EdmondsKarp(Vertex* s, Vertex* t) {
-    double maxFlow = 0.0;
-    auto bfs = [this, &s, &t]() -> double {
-        for (auto v: vertexSet) {
-            v->setVisited(false);
+    return maxFlow(s, t, FlowAlgorithm::EdmondsKarp);
+}
+
+double Graph::Dinic(Vertex* s, Vertex* t) {
+    return maxFlow(s, t, FlowAlgorithm::Dinic);
+}
+
+const GomoryHuTree &Graph::getGomoryHuTree(FlowAlgorithm algorithm) {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    const FlowNetwork &net = getFlowNetwork();
+    if (gomoryHuTree == nullptr || gomoryHuVersion != getVersion()) {
+        gomoryHuTree = std::make_shared<GomoryHuTree>(net, algorithm);
+        recordStats(gomoryHuTree->getStats());
+        gomoryHuVersion = getVersion();
+    }
+    return *gomoryHuTree;
+}
+
+const PairFlowMatrix &Graph::getPairFlows(FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    const FlowNetwork &net = getFlowNetwork();
+    if (pairFlows == nullptr || pairFlowsVersion != getVersion()) {
+        if (method == PairsMethod::GomoryHu) {
+            pairFlows = std::make_shared<PairFlowMatrix>(getGomoryHuTree(algorithm));
+        } else {
+            pairFlows = std::make_shared<PairFlowMatrix>(net, algorithm, method == PairsMethod::Parallel ? threads : 1);
+            recordStats(pairFlows->getStats());
         }
-        std::queue<Vertex *> q;
-        s->setVisited(true);
-        q.push(s);
-
-        std::unordered_map<Vertex *, Edge *> prev;
-        while (!q.empty()) {
-            Vertex *currVertex = q.front();
-            q.pop();
-            if (currVertex == t) break;
-            for (auto adj: currVertex->getAdj()) {
-                if (adj->getDest()->isVisited() || adj->getWeight() - adj->getFlow() <= 0.0) {
-                    continue;
-                }
-                adj->getDest()->setVisited(true);
-                prev[adj->getDest()] = adj;
-                q.push(adj->getDest());
+        pairFlowsVersion = getVersion();
+    }
+    return *pairFlows;
+}
+
+double Graph::GomoryHuMaxFlow(Vertex* s, Vertex* t) {
+    const GomoryHuTree &tree = getGomoryHuTree();
+    const FlowNetwork &net = getFlowNetwork();
+    int si = net.indexOf(s);
+    int ti = net.indexOf(t);
+    if (si == -1 || ti == -1) return 0.0;
+    return tree.maxFlow(si, ti);
+}
+
+double Graph::PushRelabel(Vertex* s, Vertex* t) {
+    return maxFlow(s, t, FlowAlgorithm::PushRelabel);
+}
+
+double Graph::maxFlow(Vertex* s, Vertex* t, FlowAlgorithm algorithm) {
+    // Every algorithm finds the same value, so the algorithm is not part of the key
+    ResultKey key = {s, t, CachedQuery::MaxFlow, getVersion()};
+    std::pair<double, double> result;
+    if (resultCache.lookup(key, result)) return result.first;
+
+    std::shared_ptr<FlowContextPool> pool = getContextPool();
+    const FlowNetwork &net = pool->getNetwork();
+    int si = net.indexOf(s);
+    int ti = net.indexOf(t);
+    if (si == -1 || ti == -1) return 0.0;
+    std::unique_ptr<FlowContext> ctx = pool->acquire();
+    double flow = net.maxFlow(si, ti, algorithm, *ctx);
+    recordStats(*ctx);
+    pool->release(std::move(ctx));
+    resultCache.insert(key, {flow, 0.0});
+    return flow;
+}
+
+std::vector<std::pair<Vertex *, Vertex *>> Graph::topPairs(int k, FlowAlgorithm algorithm, PairsMethod method, unsigned threads) {
+    const FlowNetwork &net = getFlowNetwork();
+    const PairFlowMatrix &flows = getPairFlows(algorithm, method, threads);
+    int n = flows.getNumVertices();
+    if (k <= 0) return {};
+
+    // Min-heap of the best k pairs seen so far, the weakest on top
+    using Candidate = std::pair<double, std::pair<int, int>>;
+    auto weaker = [](const Candidate &left, const Candidate &right) {
+        if (left.first != right.first) return left.first > right.first;
+        return left.second < right.second;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(weaker)> best(weaker);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            Candidate candidate = {flows.get(i, j), {i, j}};
+            if ((int) best.size() < k) {
+                best.push(candidate);
+            } else if (weaker(candidate, best.top())) {
+                best.pop();
+                best.push(candidate);
             }
         }
-        if (prev.find(t) == prev.end()) return 0.0;
-        double bottleNeck = std::numeric_limits<double>::max();
-        for (auto e = prev[t]; e != nullptr; e = prev[e->getOrig()]) {
-            bottleNeck = std::min(bottleNeck, e->getWeight() - e->getFlow());
-        }
-        for (auto e = prev[t]; e != nullptr; e = prev[e->getOrig()]) {
-            e->setFlow(e->getFlow() + bottleNeck);
-            e->getReverse()->setFlow(e->getReverse()->getFlow() - bottleNeck);
-        }
-        return bottleNeck;
-    };
-    double flow;
-    while ((flow = bfs()) > 0.0) {
-        maxFlow += flow;
     }
-    return maxFlow;
+
+    std::vector<std::pair<Vertex *, Vertex *>> result(best.size());
+    for (size_t i = result.size(); i-- > 0; best.pop()) {
+        result[i] = {net.vertexAt(best.top().second.first), net.vertexAt(best.top().second.second)};
+    }
+    return result;
+}
+
+ContingencySweep Graph::sweepSegmentFailures(const std::vector<std::pair<Vertex *, Vertex *>> &pairs, FlowAlgorithm algorithm, unsigned threads) {
+    std::shared_ptr<FlowContextPool> pool = getContextPool();
+    const FlowNetwork &net = pool->getNetwork();
+    std::vector<std::pair<int, int>> indices;
+    for (const auto &pair : pairs) {
+        int s = net.indexOf(pair.first);
+        int t = net.indexOf(pair.second);
+        if (s != -1 && t != -1) indices.emplace_back(s, t);
+    }
+    ContingencySweep sweep(net, indices, algorithm, threads);
+    recordStats(sweep.getStats());
+    return sweep;
 }
 
-std::vector<std::string> Graph::MostAffectStations(Graph rc){
+std::unique_ptr<FlowContext> Graph::acquireContext(FlowContextPool &pool, const Scenario &scenario) {
+    // A scenario of an older network cannot use the pool, whose contexts are sized for the current one
+    std::unique_ptr<FlowContext> ctx = &pool.getNetwork() == &scenario.getNetwork() ? pool.acquire() : std::make_unique<FlowContext>(scenario.getNetwork());
+    ctx->setCapacities(scenario.getCapacities());
+    return ctx;
+}
+
+void Graph::releaseContext(FlowContextPool &pool, const Scenario &scenario, std::unique_ptr<FlowContext> ctx) {
+    recordStats(*ctx);
+    ctx->setCapacities(nullptr);
+    if (&pool.getNetwork() == &scenario.getNetwork()) {
+        pool.release(std::move(ctx));
+    }
+}
+
+double Graph::maxFlow(Vertex* s, Vertex* t, FlowAlgorithm algorithm, const Scenario &scenario) {
+    std::shared_ptr<FlowContextPool> pool = getContextPool();
+    const FlowNetwork &net = scenario.getNetwork();
+    int si = net.indexOf(s);
+    int ti = net.indexOf(t);
+    if (si == -1 || ti == -1) return 0.0;
+    std::unique_ptr<FlowContext> ctx = acquireContext(*pool, scenario);
+    double flow = net.maxFlow(si, ti, algorithm, *ctx);
+    releaseContext(*pool, scenario, std::move(ctx));
+    return flow;
+}
+
+Scenario Graph::createScenario() {
+    std::lock_guard<std::recursive_mutex> lock(cacheMutex);
+    getFlowNetwork();
+    return Scenario(network);
+}
+
+std::vector<std::string> Graph::MostAffectStations(const Scenario &scenario, FlowAlgorithm algorithm){
+    std::shared_ptr<FlowContextPool> pool = getContextPool();
+    const FlowNetwork &net = scenario.getNetwork();
+
+    // The repair needs a complete flow to start from, which push-relabel does not leave behind
+    FlowAlgorithm baseAlgorithm = algorithm == FlowAlgorithm::PushRelabel ? FlowAlgorithm::Dinic : algorithm;
+    std::unique_ptr<FlowContext> ctx = acquireContext(*pool, scenario);
+
     int maxdiff = -1;
     std::unordered_set<std::string> addedPairs;
-    for (auto& source : vertexSet) {
+    for (int s = 0; s < net.getNumVertices(); s++) {
+        Vertex *source = net.vertexAt(s);
         for (auto& connection : source->getAdj()) {
             Vertex* destinationVertex = connection->getDest();
             const auto& destination = destinationVertex->getName();
-
-            int floworiginal = EdmondsKarp(source, destinationVertex);
-            int flowrc = rc.EdmondsKarp(source, destinationVertex);
+            int t = net.indexOf(destinationVertex);
+            // Flows are symmetric, so each pair is evaluated from its lower index; disabled stations are not reported
+            if (t <= s || scenario.isStationDisabled(s) || scenario.isStationDisabled(t)) continue;
+
+            ctx->setCapacities(nullptr);
+            int floworiginal = (int) net.maxFlow(s, t, baseAlgorithm, *ctx);
+            ctx->setCapacities(scenario.getCapacities());
+            int flowrc = (int) net.repairMaxFlow(s, t, scenario.getChangedArcs(), algorithm, *ctx);
             if(flowrc != floworiginal){
                 if(abs(floworiginal-flowrc) > maxdiff){
                     maxdiff = abs(floworiginal-flowrc);
@@ -221,6 +499,8 @@ std::vector<std::string> Graph::MostAffectStations(Graph rc){
             }
         }
     }
+    releaseContext(*pool, scenario, std::move(ctx));
+
     std::vector<std::string> result;
     for(auto i: addedPairs){
         result.push_back(i);
@@ -11,16 +11,50 @@
 #include <list>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include "VertexEdge.h"
+#include "FlowNetwork.h"
+#include "GomoryHuTree.h"
+#include "PairFlowMatrix.h"
+#include "Scenario.h"
+#include "ContingencySweep.h"
+#include "MinCostFlow.h"
+#include "ResultCache.h"
+#include <functional>
+
+/**
+ * @brief Ways of computing the maximum flow of every pair of vertices.
+ */
+enum class PairsMethod {
+    Exhaustive, // one max-flow computation per pair
+    Parallel,   // one max-flow computation per pair, spread over a pool of worker threads
+    GomoryHu    // V-1 max-flow computations, pairs answered from the Gomory-Hu tree
+};
 
 class Graph {
 public:
+    Graph() = default;
+
+    /**
+     * @brief Graph class copy constructor.
+     *
+     * The copy shares the Vertex objects of the original graph, as the default copy did, and the arenas that own them, which
+     * are freed with the last graph that uses them. It starts with empty flow caches (residual network, Gomory-Hu tree and
+     * pairwise flows) that it builds on first use.
+     *
+     * @param other The graph to copy.
+     */
+    Graph(const Graph &other);
+
     /**
      * @brief Graph class destructor.
      *
      * The destructor for the Graph class is responsible for deallocating the dynamically allocated memory
      * for the distance matrix and path matrix, which are used in graph algorithms.
      * It calls the helper functions 'deleteMatrix()' to delete the memory for both matrices.
+     * The stations and segments are freed in bulk with their arenas, unless a copy of the graph still uses them.
      */
     ~Graph();
 
@@ -29,16 +63,48 @@ public:
      *
      * @param name The name of the vertex to be found.
      * @return A pointer to the vertex if found, nullptr otherwise.
+     * Time Complexity: O(1) on average, through the hashed name index
      */
-    Vertex *findVertex(const std::string &name) const;
+    Vertex *findVertex(std::string_view name) const;
 
     /**
-     * @brief Adds a vertex to the graph.
+     * @brief Creates a vertex owned by the graph and adds it.
+     *
+     * The vertex is constructed in the vertex arena of the graph, and its edges will be allocated in the edge arena, so
+     * loading a network costs one allocation per chunk of stations or segments. It gets the next dense identifier and is
+     * registered in the name index.
      *
-     * @param vertex A pointer to the vertex to be added.
-     * @return true if the vertex was added successfully, false otherwise.
+     * @param name The name of the station.
+     * @param district The district of the station.
+     * @param municipality The municipality of the station.
+     * @param township The township of the station.
+     * @param line The line of the station.
+     * @return The new vertex, or nullptr if a vertex with the same name already exists.
+     * Time Complexity: O(1) on average
      */
-    bool addVertex(Vertex *vertex);
+    Vertex *addVertex(const std::string &name, const std::string &district = "", const std::string &municipality = "", const std::string &township = "", const std::string &line = "");
+
+    /**
+     * @brief Creates a vertex owned by the graph from attributes already interned in getStrings(), and adds it.
+     *
+     * Loaders that intern every distinct string once use it to add stations without building a string per field.
+     *
+     * @param name The code of the name of the station.
+     * @param district The code of the district of the station.
+     * @param municipality The code of the municipality of the station.
+     * @param township The code of the township of the station.
+     * @param line The code of the line of the station.
+     * @return The new vertex, or nullptr if a vertex with the same name already exists.
+     * Time Complexity: O(1) on average
+     */
+    Vertex *addVertex(uint32_t name, uint32_t district, uint32_t municipality, uint32_t township, uint32_t line);
+
+    /**
+     * @brief Gets the string table of the graph, which holds the names and attributes of the stations and the services.
+     *
+     * @return The string table, shared by the copies of the graph.
+     */
+    StringTable &getStrings();
 
     /**
      * @brief Adds a bidirectional edge between two vertices in the graph.
@@ -51,13 +117,34 @@ public:
      */
     bool addBidirectionalEdge(Vertex *v1, Vertex *v2, double w, std::string service);
 
+    /**
+     * @brief Adds a bidirectional edge between two vertices in the graph, with a service already interned in getStrings().
+     *
+     * @param v1 Pointer to the first vertex.
+     * @param v2 Pointer to the second vertex.
+     * @param w Weight of the edge.
+     * @param service The code of the service associated with the edge.
+     * @return true if the edge was added successfully, false otherwise.
+     */
+    bool addBidirectionalEdge(Vertex *v1, Vertex *v2, double w, uint32_t service);
+
+    /**
+     * @brief Removes the segment between two stations, in both directions.
+     *
+     * @param origName The name of one of the stations.
+     * @param destName The name of the other station.
+     * @return true if at least one edge was removed, false otherwise.
+     */
+    bool removeEdge(const std::string &origName, const std::string &destName);
+
     /**
      * @brief Implements the Edmonds-Karp algorithm to compute the maximum flow in the graph from a source vertex to a target vertex.
      *
      * The function implements the Edmonds-Karp algorithm to compute the maximum flow in the graph from a source vertex to a target vertex.
-     * It takes two Vertex pointers, representing the source and target vertices, as input. It uses a lambda function for Breadth-First Search (BFS)
-     * to find augmenting paths from the source to the target. The lambda function performs the BFS and updates the flow of the edges in the augmenting path.
-     * The function maintains a running total of the maximum flow and returns it as the result.
+     * It takes two Vertex pointers, representing the source and target vertices, as input. The computation runs over the CSR residual
+     * network returned by getFlowNetwork(), where augmenting paths are found with a Breadth-First Search (BFS) over contiguous arrays.
+     * Each call borrows its own FlowContext, so consecutive queries do not affect each other and concurrent calls are safe
+     * as long as the graph is not being changed at the same time.
      *
      * @param s The source vertex.
      * @param t The target vertex.
@@ -67,83 +154,422 @@ public:
     double EdmondsKarp(Vertex* s,Vertex* t);
 
     /**
-     * @brief Computes the maximum flow between pairs of vertices in the graph using the Edmonds-Karp algorithm.
+     * @brief Implements Dinic's algorithm to compute the maximum flow in the graph from a source vertex to a target vertex.
+     *
+     * The function runs Dinic's algorithm over the CSR residual network returned by getFlowNetwork(). Each phase builds a level graph
+     * with a BFS and saturates it with a blocking flow found through current-arc pointers, so far fewer BFS sweeps are needed than in
+     * Edmonds-Karp, which finds a single augmenting path per sweep.
+     *
+     * @param s The source vertex.
+     * @param t The target vertex.
+     * @return The maximum flow from the source to the target vertex.
+     * Time Complexity: O(V^2 E)
+     */
+    double Dinic(Vertex* s,Vertex* t);
+
+    /**
+     * @brief Implements the highest-label push-relabel algorithm to compute the maximum flow in the graph from a source vertex to a target vertex.
+     *
+     * The function runs push-relabel over the CSR residual network returned by getFlowNetwork(), always discharging the active vertex
+     * with the highest label. Global relabeling and gap relabeling keep the labels close to the real distances to the target, which
+     * avoids the long chains of relabels that the plain algorithm suffers on long railway lines.
+     *
+     * @param s The source vertex.
+     * @param t The target vertex.
+     * @return The maximum flow from the source to the target vertex.
+     * Time Complexity: O(V^2 sqrt(E))
+     */
+    double PushRelabel(Vertex* s,Vertex* t);
+
+    /**
+     * @brief Computes the maximum flow from a source vertex to a target vertex with the selected algorithm.
+     *
+     * @param s The source vertex.
+     * @param t The target vertex.
+     * @param algorithm The max-flow algorithm to use.
+     * @return The maximum flow from the source to the target vertex.
+     */
+    double maxFlow(Vertex* s,Vertex* t,FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp);
+
+    /**
+     * @brief Computes the maximum flow from a source vertex to a target vertex under a what-if scenario.
+     *
+     * @param s The source vertex.
+     * @param t The target vertex.
+     * @param algorithm The max-flow algorithm to use.
+     * @param scenario The scenario, created with createScenario().
+     * @return The maximum flow from the source to the target vertex with the capacities of the scenario.
+     */
+    double maxFlow(Vertex* s,Vertex* t,FlowAlgorithm algorithm, const Scenario &scenario);
+
+    /**
+     * @brief Computes the maximum flow from a set of sources to a set of sinks.
+     *
+     * Each source is fed by a virtual super-source and each sink drains into a virtual super-sink, through an arc with the
+     * given capacity. The virtual nodes live in the query context, so the graph is left untouched and concurrent queries are safe.
+     *
+     * @param sources The source vertices and the capacity of their virtual arcs.
+     * @param sinks The sink vertices and the capacity of their virtual arcs, INF for no limit.
+     * @return The maximum flow from the sources to the sinks.
+     * Time Complexity: O(VE^2)
+     */
+    double maxFlow(const std::vector<std::pair<Vertex *, double>> &sources, const std::vector<std::pair<Vertex *, double>> &sinks);
+
+    /**
+     * @brief Creates an empty what-if scenario on the current network, see Scenario.
+     *
+     * The scenario keeps the network it was created on, so it stays usable, and describes that network, even if the graph changes later.
      *
-     * The function finds the maximum flow between pairs of vertices in the graph using the Edmonds-Karp algorithm.
-     * It iterates over all pairs of vertices in the graph, computes the maximum flow between each pair using the
-     * Edmonds-Karp algorithm, and keeps track of the pairs with the maximum flow. The result is printed to the standard
-     * output along with the execution time in milliseconds.
+     * @return The scenario, with no stations or segments disabled.
+     * Time Complexity: O(V + E)
      */
-    void MaxFlowBetweenPairs();
+    Scenario createScenario();
 
     /**
-     * @brief Computes the top districts with the highest maximum flow between pairs of vertices in the graph using the Edmonds-Karp algorithm.
+     * @brief Computes the maximum flow between pairs of vertices in the graph.
      *
-     * The function computes the top districts with the highest maximum flow between pairs of vertices in the graph using the Edmonds-Karp algorithm.
-     * It iterates over all pairs of vertices in the graph, computes the maximum flow between each pair using the Edmonds-Karp algorithm,
-     * and accumulates the maximum flow for each district. Then, it sorts the districts based on their accumulated maximum flow in descending order
-     * and prints the top districts along with their accumulated maximum flow to the standard output.
+     * The function iterates over all pairs of vertices in the graph, reads the maximum flow between each pair from the shared
+     * matrix returned by getPairFlows() and keeps track of the pairs with the maximum flow, in (i, j) order.
+     * Each of these pairs is printed to the standard output, one per line.
+     *
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * Time Complexity: O(V^2), after the pairwise flows have been computed
+     */
+    void MaxFlowBetweenPairs(FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
+
+    /**
+     * @brief Gets the maximum flow between two vertices from the Gomory-Hu tree of the graph.
+     *
+     * @param s The source vertex.
+     * @param t The target vertex.
+     * @return The maximum flow between the two vertices.
+     * Time Complexity: O(V), after the tree has been built
+     */
+    double GomoryHuMaxFlow(Vertex* s, Vertex* t);
+
+    /**
+     * @brief Computes the top districts with the highest maximum flow between pairs of vertices in the graph.
+     *
+     * The function reads the maximum flow of every pair of vertices in different districts from the shared matrix returned by
+     * getPairFlows(), and accumulates the maximum flow for each district. Then, it sorts the districts based on their accumulated
+     * maximum flow in descending order and prints the top districts along with their accumulated maximum flow to the standard output.
      *
      * @param k The number of top districts to print.
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * Time Complexity: O(V^2), after the pairwise flows have been computed
      */
-    void topDistricts(int k);
+    void topDistricts(int k, FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
 
     /**
-     * @brief Computes the top municipalities with the highest maximum flow between pairs of vertices in the graph using the Edmonds-Karp algorithm.
+     * @brief Computes the top municipalities with the highest maximum flow between pairs of vertices in the graph.
      *
-     * The function computes the top municipalities with the highest maximum flow between pairs of vertices in the graph using the Edmonds-Karp algorithm.
-     * It iterates over all pairs of vertices in the graph, computes the maximum flow between each pair using the Edmonds-Karp algorithm,
-     * and accumulates the maximum flow for each municipality. Then, it sorts the municipalities based on their accumulated maximum flow in descending order
-     * and prints the top municipalities along with their accumulated maximum flow to the standard output.
+     * The function reads the maximum flow of every pair of vertices in different municipalities from the shared matrix returned by
+     * getPairFlows(), and accumulates the maximum flow for each municipality. Then, it sorts the municipalities based on their accumulated
+     * maximum flow in descending order and prints the top municipalities along with their accumulated maximum flow to the standard output.
      *
      * @param k The number of top municipalities to print.
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * Time Complexity: O(V^2), after the pairwise flows have been computed
      */
-    void topMunicipalities(int k);
+    void topMunicipalities(int k, FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
 
     /**
      * @brief Computes the maximum number of trains that can simultaneously arrive at a given station in the graph using the Edmonds-Karp algorithm.
      *
      * The function computes the maximum number of trains that can simultaneously arrive at a given station in the graph using the Edmonds-Karp algorithm.
-     * It adds a source vertex to the graph and connects it to all adjacent vertices of the given station. Then, it runs the Edmonds-Karp algorithm
-     * to compute the maximum flow from the source vertex to the given station, which represents the maximum number of trains that can simultaneously arrive at the station.
-     * Finally, it removes the source vertex and the edges added to the graph.
+     * Every adjacent vertex of the station is a source, fed by a virtual super-source with the capacity of the segment that joins it to the station,
+     * and the station is the sink. The super-source only exists for the duration of the query, so the graph is not modified.
      *
      * @param station The station vertex for which to compute the maximum number of trains that can simultaneously arrive.
      * Time Complexity: O(E^2 V)
      */
     void maxTrainsAtStation(Vertex *station);
+
+    /**
+     * @brief Computes the maximum number of trains that can simultaneously arrive at a given station, without printing it.
+     *
+     * @param station The station vertex for which to compute the maximum number of trains that can simultaneously arrive.
+     * @return The maximum number of trains.
+     * Time Complexity: O(E^2 V)
+     */
+    double getMaxTrainsAtStation(Vertex *station);
+
+    /**
+     * @brief Computes the maximum number of trains between two stations and the minimum cost of running them.
+     *
+     * Every train pays the cost of the service of each segment it crosses, as set by setServiceCost(). The result is an optimal
+     * minimum-cost maximum flow, computed by MinCostFlowNetwork with successive shortest paths.
+     *
+     * @param source The source station.
+     * @param destination The destination station.
+     * @return The maximum number of trains and their minimum total cost.
+     * @throw std::runtime_error If a segment has a service without a cost.
+     * Time Complexity: O(F (V + E) log V), F being the number of shortest path phases
+     */
+    std::pair<double, double> minCostTrains(Vertex *source, Vertex *destination);
+
+    /**
+     * @brief Sets the cost per train of a service. STANDARD costs 2€ and ALFA PENDULAR 4€ unless changed.
+     *
+     * Only minimum-cost results and the minimum-cost network are invalidated, the version of the graph does not change.
+     *
+     * @param service The name of the service.
+     * @param cost The cost per train of each segment with the service.
+     */
+    void setServiceCost(const std::string &service, double cost);
+
+    /**
+     * @brief Ranks the districts by the maximum flow of the pairs of vertices with one vertex in the district and the other outside it.
+     *
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * @return The districts and their accumulated flow, sorted by decreasing flow.
+     * Time Complexity: O(V^2), after the pairwise flows have been computed
+     */
+    std::vector<std::pair<std::string, double>> rankDistricts(FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
+
+    /**
+     * @brief Ranks the municipalities by the maximum flow of the pairs of vertices with one vertex in the municipality and the other outside it.
+     *
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * @return The municipalities and their accumulated flow, sorted by decreasing flow.
+     * Time Complexity: O(V^2), after the pairwise flows have been computed
+     */
+    std::vector<std::pair<std::string, double>> rankMunicipalities(FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
     /**
      * @brief Gets the vector of vertices in the graph.
      *
+     * The vector is returned by reference and is invalidated by addVertex and removeVertex.
+     *
      * @return A vector containing pointers to all the vertices in the graph.
      */
-    std::vector<Vertex *> getVertexSet() const;
+    const std::vector<Vertex *> &getVertexSet() const;
+
+    /**
+     * @brief Gets the version of the graph, which changes whenever a station, a segment or a capacity changes.
+     *
+     * It is a single counter, incremented by the graph and by its vertices, so edges added, removed or reweighted directly
+     * on the vertices are noticed too. Copies share it, as they share the vertices.
+     *
+     * @return The version of the graph.
+     */
+    unsigned long getVersion() const;
+
+    /**
+     * @brief Gets the cache of the results of maxFlow, getMaxTrainsAtStation and minCostTrains.
+     *
+     * Results are keyed by their stations, the kind of query and the version of the graph, so a change to the graph makes
+     * every older result unreachable. The cache exports its hit and miss counters and its capacity can be changed.
+     *
+     * @return The result cache.
+     */
+    ResultCache &getResultCache();
+
+    /**
+     * @brief Drops every cached network, tree, matrix and result, so the next queries compute them again.
+     *
+     * References and pointers obtained earlier stay valid only as long as the objects they refer to are kept alive by their
+     * owners, as for a change to the graph. Used by the benchmarks to time cold queries.
+     */
+    void clearCaches();
+
+    /**
+     * @brief Gets the work done by the max-flow solvers on behalf of the graph since it was created or last reset.
+     *
+     * Single queries, scenarios, the Gomory-Hu tree, the pairwise flows of the all-pairs reports and the contingency sweeps
+     * all add to these statistics, from every thread. A report answered from a cached matrix adds nothing. FlowStats::dump
+     * writes them as JSON.
+     *
+     * @return A copy of the statistics.
+     */
+    FlowStats getFlowStats();
+
+    /**
+     * @brief Clears the statistics returned by getFlowStats.
+     */
+    void resetFlowStats();
 
     /**
      * @brief Removes a vertex from the graph by station name.
      *
+     * The vertices after the removed one move down one position, so their identifiers stay dense and in load order.
+     *
      * @param station_name The name of the vertex (station) to be removed.
      * @return True if the vertex was successfully removed, false otherwise.
+     * Time Complexity: O(V + deg(v)^2)
      */
     bool removeVertex(const std::string& station_name);
 
     /**
-     * @brief Computes the most affected stations in the graph by comparing the maximum flow with another graph.
+     * @brief Gets the pairs of vertices with the highest maximum flow.
+     *
+     * @param k The number of pairs.
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * @return Up to k pairs, by decreasing maximum flow, ties in index order.
+     * Time Complexity: O(V^2 log k), after the pairwise flows have been computed
+     */
+    std::vector<std::pair<Vertex *, Vertex *>> topPairs(int k, FlowAlgorithm algorithm = FlowAlgorithm::Dinic, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
+
+    /**
+     * @brief Runs an N-1 contingency sweep: ranks every segment by the maximum flow the given pairs lose when it fails alone.
+     *
+     * @param pairs The origin-destination pairs, for example the result of topPairs().
+     * @param algorithm The max-flow algorithm to use.
+     * @param threads Number of worker threads, 0 for one per hardware thread.
+     * @return The sweep, see ContingencySweep.
+     * Time Complexity: P max-flow computations plus one repair for every segment crossed by the flow of each pair
+     */
+    ContingencySweep sweepSegmentFailures(const std::vector<std::pair<Vertex *, Vertex *>> &pairs, FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, unsigned threads = 0);
+
+    /**
+     * @brief Computes the stations most affected by the stations and segments a scenario removes from the network.
      *
-     * The function computes the most affected stations in the graph by comparing the maximum flow of each edge in the graph with another graph.
-     * It takes a Graph object 'rc' as input, which represents another graph for comparison.
-     * The function iterates over all vertices and their adjacent edges in the graph and computes the maximum flow using the Edmonds-Karp algorithm
-     * for each edge. It then compares the maximum flow of the edge in the original graph with the corresponding edge in 'rc' graph.
-     * If the maximum flows are different, the function calculates the absolute difference and keeps track of the maximum difference found so far.
-     * It also maintains a set of added station pairs to avoid duplicates. The function returns a vector of strings representing the most affected stations.
+     * For every pair of stations joined by a segment, the maximum flow in the full network is compared with the maximum flow
+     * under the scenario. The scenario flow is not computed from zero: the flow of the full network is repaired with
+     * FlowNetwork::repairMaxFlow, which only moves the flow that crossed the changed arcs. The graph itself is not modified.
+     * The stations of the pairs with the largest difference are returned; disabled stations are not reported.
      *
-     * @param rc The graph to compare with for computing most affected stations.
-     * @return A vector of strings representing the most affected stations.
-     * Time Complexity: O(V^2 E^2)
+     * @param scenario The reduced network, created with createScenario().
+     * @param algorithm The max-flow algorithm used for the full network and to augment the repaired flows.
+     * @return The names of the most affected stations, empty if no flow changes.
+     * Time Complexity: O(E) max-flow computations and repairs
      */
-    std::vector<std::string> MostAffectStations(Graph rc);
+    std::vector<std::string> MostAffectStations(const Scenario &scenario, FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp);
+
+    /**
+     * @brief Gets the CSR residual network of the graph.
+     *
+     * The network is built from the vertex set on the first call and rebuilt only after the graph has been changed
+     * through addVertex, addBidirectionalEdge, removeVertex or removeEdge. The build is guarded by a lock, so concurrent
+     * queries on an unchanged graph may all trigger it.
+     *
+     * @return A reference to the residual network.
+     * Time Complexity: O(V + E) when the network has to be rebuilt, O(1) otherwise
+     */
+    const FlowNetwork &getFlowNetwork();
+
+    /**
+     * @brief Gets the Gomory-Hu tree of the graph.
+     *
+     * The tree is built with Gusfield's algorithm on the first call and rebuilt only after the graph has changed.
+     * Since maximum flows are unique, a tree built with any algorithm answers every later call.
+     *
+     * @param algorithm The max-flow algorithm used for the V-1 cuts if the tree has to be built.
+     * @return A reference to the tree, whose vertex indices are those of getFlowNetwork().
+     * Time Complexity: V-1 max-flow computations when the tree has to be built, O(1) otherwise
+     */
+    const GomoryHuTree &getGomoryHuTree(FlowAlgorithm algorithm = FlowAlgorithm::Dinic);
+
+    /**
+     * @brief Gets the maximum flow of every pair of vertices, shared by MaxFlowBetweenPairs, topDistricts and topMunicipalities.
+     *
+     * The matrix is computed on the first call and kept until the graph is changed by addVertex, addBidirectionalEdge,
+     * removeVertex or removeEdge, so running several reports on the same network pays for the pairwise flows only once.
+     * With PairsMethod::Exhaustive every pair runs its own max-flow computation; PairsMethod::Parallel does the same on a pool
+     * of worker threads, each with its own FlowContext; with PairsMethod::GomoryHu the flows are read from the Gomory-Hu tree,
+     * which only needs V-1 max-flow computations. Maximum flows are unique, so a matrix computed with any method and algorithm
+     * answers every later call.
+     *
+     * @param algorithm The max-flow algorithm used if the matrix has to be computed.
+     * @param method How the pairwise flows are computed if the matrix has to be computed.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * @return A reference to the matrix, whose vertex indices are those of getFlowNetwork().
+     * Time Complexity: O(V^2) plus V-1 max-flow computations with PairsMethod::GomoryHu, V(V-1)/2 max-flow computations otherwise
+     */
+    const PairFlowMatrix &getPairFlows(FlowAlgorithm algorithm = FlowAlgorithm::Dinic, PairsMethod method = PairsMethod::GomoryHu, unsigned threads = 0);
 protected:
-    std::vector<Vertex *> vertexSet;    // vertex set
+    /**
+     * @brief Gets the pool of flow contexts of the current residual network, building the network if needed.
+     *
+     * @return The pool, which keeps its network alive even if the graph rebuilds it later.
+     */
+    std::shared_ptr<FlowContextPool> getContextPool();
+
+    /**
+     * @brief Takes a flow context for the network of a scenario, set to the capacities of the scenario.
+     *
+     * @param pool The pool of the current network, used when the scenario was created on it.
+     * @param scenario The scenario.
+     * @return The context, to be given back with releaseContext.
+     */
+    std::unique_ptr<FlowContext> acquireContext(FlowContextPool &pool, const Scenario &scenario);
+
+    /**
+     * @brief Gives back a context taken with acquireContext.
+     *
+     * @param pool The pool the context was taken from.
+     * @param scenario The scenario the context was taken for.
+     * @param ctx The context.
+     */
+    void releaseContext(FlowContextPool &pool, const Scenario &scenario, std::unique_ptr<FlowContext> ctx);
+
+    /**
+     * @brief Gets the minimum-cost flow network of the current graph, building it if needed.
+     *
+     * @return The network, which stays alive even if the graph rebuilds it later.
+     * Time Complexity: O(V + E) when the network has to be built, O(1) otherwise
+     */
+    std::shared_ptr<const MinCostFlowNetwork> getMinCostNetwork();
+
+    /**
+     * @brief Adds statistics to those returned by getFlowStats.
+     *
+     * @param stats The statistics to add.
+     */
+    void recordStats(const FlowStats &stats);
+
+    /**
+     * @brief Adds the statistics of a context to those returned by getFlowStats and clears them in the context.
+     *
+     * @param ctx The context, about to be given back to its pool.
+     */
+    void recordStats(FlowContext &ctx);
+
+    /**
+     * @brief Accumulates, for every group of vertices, the maximum flow of the pairs whose vertices belong to different groups.
+     *
+     * @param groupOf Function that gives the code of the group of a vertex in the string table, such as its district or municipality.
+     * @param algorithm The max-flow algorithm used if the pairwise flows have to be computed.
+     * @param method How the pairwise flows are computed if they are not available yet.
+     * @param threads Number of worker threads for PairsMethod::Parallel, 0 for one per hardware thread.
+     * @return The groups and their accumulated flow, sorted by decreasing flow.
+     * Time Complexity: O(V^2 + G log G), for G groups, after the pairwise flows have been computed
+     */
+    std::vector<std::pair<std::string, double>> rankGroups(const std::function<uint32_t(const Vertex *)> &groupOf, FlowAlgorithm algorithm, PairsMethod method, unsigned threads);
+
+    std::shared_ptr<GraphStorage> storage = std::make_shared<GraphStorage>();            // strings, edges and version, shared by copies
+    std::shared_ptr<Arena<Vertex>> vertexArena = std::make_shared<Arena<Vertex>>(1024);    // owns every vertex, shared by copies
+    std::vector<Vertex *> vertexSet;    // vertex set, indexed by vertex identifier
+    std::unordered_map<std::string_view, int> nameIndex;    // identifier of each vertex by name, viewed in the string table
+
+    std::recursive_mutex cacheMutex;           // guards the lazily built network, tree and matrix below
+    unsigned long networkVersion = 0;          // version of the graph the network was built from
+    std::shared_ptr<FlowNetwork> network;
+    std::shared_ptr<FlowContextPool> contextPool;  // contexts of the single-query entry points
+    unsigned long gomoryHuVersion = 0;         // version of the graph the tree was built from
+    std::shared_ptr<GomoryHuTree> gomoryHuTree;
+    unsigned long pairFlowsVersion = 0;        // version of the graph the pairwise flows were computed from
+    std::shared_ptr<PairFlowMatrix> pairFlows;
+    unsigned long minCostVersion = 0;          // version of the graph the minimum-cost network was built from
+    unsigned long minCostEpoch = 0;            // service costs epoch the minimum-cost network was built with
+    std::shared_ptr<MinCostFlowNetwork> minCostNetwork;
+
+    std::unordered_map<std::string, double> serviceCosts = {{"STANDARD", 2.0}, {"ALFA PENDULAR", 4.0}};   // cost per train of each service
+    std::atomic<unsigned long> costEpoch{1};   // incremented on every service cost change, only read by minimum-cost queries
+    ResultCache resultCache;                   // recent results of the single-query entry points
+    std::mutex statsMutex;                     // guards flowStats
+    FlowStats flowStats;                       // work of the solvers, see getFlowStats
 
     double ** distMatrix = nullptr;
     int **pathMatrix = nullptr;
@@ -0,0 +1,148 @@
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include "MinCostFlow.h"
+
+namespace {
+
+// Reduced costs are sums of doubles, so arcs within this tolerance of zero are on a shortest path
+const double COST_EPSILON = 1e-9;
+
+}
+
+MinCostFlowNetwork::MinCostFlowNetwork(const std::vector<Vertex *> &vertexSet, const std::unordered_map<std::string, double> &serviceCosts): vertices(vertexSet) {
+    int n = (int) vertices.size();
+    first.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        for (Edge *e : vertices[i]->getAdj()) {
+            int d = indexOf(e->getDest());
+            if (d == -1) continue;
+            first[i + 1]++;
+            first[d + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        first[i + 1] += first[i];
+    }
+
+    int m = first[n];
+    head.assign(m, -1);
+    capacity.assign(m, 0.0);
+    cost.assign(m, 0.0);
+    reverse.assign(m, -1);
+    std::vector<int> next(first.begin(), first.end() - 1);
+    for (int i = 0; i < n; i++) {
+        for (Edge *e : vertices[i]->getAdj()) {
+            int d = indexOf(e->getDest());
+            if (d == -1) continue;
+            auto it = serviceCosts.find(e->getService());
+            if (it == serviceCosts.end()) {
+                throw std::runtime_error("Invalid service type encountered: " + e->getService());
+            }
+            int a = next[i]++;
+            int r = next[d]++;
+            head[a] = d;
+            capacity[a] = e->getWeight();
+            cost[a] = it->second;
+            head[r] = i;
+            cost[r] = -it->second;
+            reverse[a] = r;
+            reverse[r] = a;
+        }
+    }
+}
+
+int MinCostFlowNetwork::getNumVertices() const {
+    return (int) vertices.size();
+}
+
+int MinCostFlowNetwork::indexOf(const Vertex *v) const {
+    int id = v->getId();
+    if (id < 0 || id >= (int) vertices.size() || vertices[id] != v) return -1;
+    return id;
+}
+
+std::pair<double, double> MinCostFlowNetwork::minCostMaxFlow(int s, int t) const {
+    if (s == t) return {0.0, 0.0};
+    int n = getNumVertices();
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> flow(head.size(), 0.0);
+    std::vector<double> potential(n, 0.0);
+    std::vector<double> dist(n);
+    std::vector<int> current(n);
+    std::vector<unsigned> visitStamp(n, 0);
+    unsigned stamp = 0;
+    std::vector<int> pathArcs;
+    double totalFlow = 0.0;
+    double totalCost = 0.0;
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    while (true) {
+        // Dijkstra on the reduced costs
+        std::fill(dist.begin(), dist.end(), infinity);
+        dist[s] = 0.0;
+        heap.push({0.0, s});
+        while (!heap.empty()) {
+            Entry top = heap.top();
+            heap.pop();
+            int u = top.second;
+            if (top.first > dist[u]) continue;
+            for (int a = first[u]; a < first[u + 1]; a++) {
+                if (capacity[a] - flow[a] <= 0.0) continue;
+                int v = head[a];
+                double reduced = std::max(0.0, cost[a] + potential[u] - potential[v]);
+                if (dist[u] + reduced < dist[v]) {
+                    dist[v] = dist[u] + reduced;
+                    heap.push({dist[v], v});
+                }
+            }
+        }
+        if (dist[t] == infinity) break;
+        // Vertices Dijkstra did not reach are at least as far as t, which keeps every residual reduced cost non-negative
+        for (int v = 0; v < n; v++) {
+            potential[v] += std::min(dist[v], dist[t]);
+        }
+
+        // Saturate the shortest paths: augment along arcs of zero reduced cost until t can no longer be reached
+        while (true) {
+            stamp++;
+            std::copy(first.begin(), first.end() - 1, current.begin());
+            pathArcs.clear();
+            visitStamp[s] = stamp;
+            int u = s;
+            while (u != t) {
+                int &a = current[u];
+                while (a < first[u + 1] && (capacity[a] - flow[a] <= 0.0 || visitStamp[head[a]] == stamp ||
+                                            cost[a] + potential[u] - potential[head[a]] > COST_EPSILON)) {
+                    a++;
+                }
+                if (a < first[u + 1]) {
+                    pathArcs.push_back(a);
+                    u = head[a];
+                    visitStamp[u] = stamp;
+                    continue;
+                }
+                // Dead end: u stays marked so it is not entered again, and the search retreats
+                if (pathArcs.empty()) break;
+                u = head[reverse[pathArcs.back()]];
+                pathArcs.pop_back();
+                current[u]++;
+            }
+            if (u != t) break;
+
+            double bottleNeck = infinity;
+            for (int a : pathArcs) {
+                bottleNeck = std::min(bottleNeck, capacity[a] - flow[a]);
+            }
+            for (int a : pathArcs) {
+                flow[a] += bottleNeck;
+                flow[reverse[a]] -= bottleNeck;
+                totalCost += bottleNeck * cost[a];
+            }
+            totalFlow += bottleNeck;
+        }
+    }
+    return {totalFlow, totalCost};
+}
@@ -0,0 +1,69 @@
+#ifndef G16_3_MINCOSTFLOW_H
+#define G16_3_MINCOSTFLOW_H
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "VertexEdge.h"
+
+/**
+ * @brief CSR network with a cost per unit of flow on every arc, for minimum-cost maximum-flow queries.
+ *
+ * Every Edge of the graph becomes a forward arc with the capacity of the edge and the cost per train of its service, plus a
+ * residual arc in the opposite direction with no capacity and the opposite cost. A railway segment, stored as two opposite
+ * edges, therefore becomes four arcs, which keeps the cost of a segment linear in the flow in either direction.
+ * Service costs are looked up once, when the network is built, so the solver only reads numbers.
+ * The network is immutable once built and every query keeps its state in local arrays, so concurrent queries are safe.
+ */
+class MinCostFlowNetwork {
+public:
+    /**
+     * @brief Builds the network from a vertex set.
+     *
+     * @param vertexSet The vertices of the graph, each at the position given by its identifier.
+     * @param serviceCosts The cost per train of each service.
+     * @throw std::runtime_error If an edge has a service without a cost.
+     * Time Complexity: O(V + E)
+     */
+    MinCostFlowNetwork(const std::vector<Vertex *> &vertexSet, const std::unordered_map<std::string, double> &serviceCosts);
+
+    /**
+     * @brief Gets the number of vertices in the network.
+     *
+     * @return The number of vertices.
+     */
+    int getNumVertices() const;
+
+    /**
+     * @brief Gets the dense index of a vertex, which is its identifier.
+     *
+     * @param v Pointer to the vertex.
+     * @return The index of the vertex, or -1 if it is not part of the network.
+     */
+    int indexOf(const Vertex *v) const;
+
+    /**
+     * @brief Computes a maximum flow of minimum total cost between two vertices with successive shortest paths.
+     *
+     * Each phase runs Dijkstra's algorithm on the reduced costs c(u, v) + h(u) - h(v), which Johnson potentials h keep
+     * non-negative, adds the distances to the potentials, and then saturates every shortest path at once by augmenting along
+     * arcs of zero reduced cost until none is left. All service costs are non-negative, so the potentials start at zero.
+     *
+     * @param s Index of the source vertex.
+     * @param t Index of the target vertex.
+     * @return The maximum flow from s to t and the minimum total cost of sending it.
+     * Time Complexity: O(F (V + E) log V) in the worst case, F being the number of shortest path phases
+     */
+    std::pair<double, double> minCostMaxFlow(int s, int t) const;
+
+protected:
+    std::vector<int> first;         // arcs of vertex i are [first[i], first[i + 1])
+    std::vector<int> head;          // destination of each arc
+    std::vector<double> capacity;   // capacity of each arc, 0 for residual arcs
+    std::vector<double> cost;       // cost per unit of flow of each arc, negated for residual arcs
+    std::vector<int> reverse;       // index of the paired arc
+
+    std::vector<Vertex *> vertices;
+};
+
+#endif //G16_3_MINCOSTFLOW_H
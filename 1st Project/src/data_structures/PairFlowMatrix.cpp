@@ -0,0 +1,49 @@
+#include <memory>
+#include "PairFlowMatrix.h"
+#include "Parallel.h"
+
+PairFlowMatrix::PairFlowMatrix(const FlowNetwork &network, FlowAlgorithm algorithm, unsigned threads, const Scenario *scenario): n(network.getNumVertices()) {
+    flows.assign((size_t) n * (n - 1) / 2, 0.0);
+    unsigned workers = resolveThreads(threads);
+    std::vector<std::unique_ptr<FlowContext>> contexts(workers);
+    parallelFor(n, workers, [&](unsigned w, size_t i) {
+        if (contexts[w] == nullptr) {
+            contexts[w] = std::make_unique<FlowContext>(network);
+            contexts[w]->setCapacities(scenario == nullptr ? nullptr : scenario->getCapacities());
+        }
+        double *row = flows.data() + rowStart((int) i);
+        for (int j = (int) i + 1; j < n; j++) {
+            row[j - i - 1] = network.maxFlow((int) i, j, algorithm, *contexts[w]);
+        }
+    });
+    for (const auto &ctx : contexts) {
+        if (ctx != nullptr) stats.merge(ctx->getStats());
+    }
+}
+
+PairFlowMatrix::PairFlowMatrix(const GomoryHuTree &tree): n(tree.getNumVertices()) {
+    flows.assign((size_t) n * (n - 1) / 2, 0.0);
+    std::vector<double> row;
+    for (int i = 0; i < n; i++) {
+        tree.flowsFrom(i, row);
+        std::copy(row.begin() + i + 1, row.end(), flows.begin() + rowStart(i));
+    }
+}
+
+const FlowStats &PairFlowMatrix::getStats() const {
+    return stats;
+}
+
+int PairFlowMatrix::getNumVertices() const {
+    return n;
+}
+
+size_t PairFlowMatrix::rowStart(int i) const {
+    return (size_t) i * n - (size_t) i * (i + 1) / 2;
+}
+
+double PairFlowMatrix::get(int i, int j) const {
+    if (i == j) return 0.0;
+    if (i > j) std::swap(i, j);
+    return flows[rowStart(i) + (j - i - 1)];
+}
@@ -0,0 +1,78 @@
+#ifndef G16_3_PAIRFLOWMATRIX_H
+#define G16_3_PAIRFLOWMATRIX_H
+#include <vector>
+#include "FlowNetwork.h"
+#include "GomoryHuTree.h"
+#include "Scenario.h"
+
+/**
+ * @brief Maximum flow of every pair of vertices of a network.
+ *
+ * Flows are symmetric on the railway network, so only the pairs (i, j) with i < j are stored, row by row, in one contiguous
+ * upper-triangular array of V(V-1)/2 values.
+ */
+class PairFlowMatrix {
+public:
+    /**
+     * @brief Fills the matrix by running one max-flow computation per pair.
+     *
+     * Rows are distributed over a pool of worker threads with parallelFor, each worker using its own FlowContext.
+     * Every row is written by a single worker, so the result does not depend on the number of threads.
+     *
+     * @param network The residual network.
+     * @param algorithm The max-flow algorithm to use.
+     * @param threads The number of worker threads, 0 for one per hardware thread.
+     * @param scenario Scenario whose capacities replace those of the network, or nullptr.
+     * Time Complexity: V(V-1)/2 max-flow computations
+     */
+    PairFlowMatrix(const FlowNetwork &network, FlowAlgorithm algorithm, unsigned threads, const Scenario *scenario = nullptr);
+
+    /**
+     * @brief Fills the matrix from the Gomory-Hu tree of the network.
+     *
+     * @param tree The Gomory-Hu tree of the network.
+     * Time Complexity: O(V^2)
+     */
+    explicit PairFlowMatrix(const GomoryHuTree &tree);
+
+    /**
+     * @brief Gets the number of vertices covered by the matrix.
+     *
+     * @return The number of vertices.
+     */
+    int getNumVertices() const;
+
+    /**
+     * @brief Gets the maximum flow between two vertices.
+     *
+     * @param i Index of one vertex.
+     * @param j Index of the other vertex.
+     * @return The maximum flow between i and j, 0 if i == j.
+     * Time Complexity: O(1)
+     */
+    double get(int i, int j) const;
+
+    /**
+     * @brief Gets the work done by the max-flow solvers while filling the matrix.
+     *
+     * A matrix read from a Gomory-Hu tree ran no computation of its own, see GomoryHuTree::getStats.
+     *
+     * @return The statistics, summed over every worker.
+     */
+    const FlowStats &getStats() const;
+
+protected:
+    /**
+     * @brief Gets the position of the first pair of row i, that is (i, i + 1), in the flows array.
+     *
+     * @param i Index of the row.
+     * @return The offset of the row.
+     */
+    size_t rowStart(int i) const;
+
+    int n;
+    std::vector<double> flows;
+    FlowStats stats;
+};
+
+#endif //G16_3_PAIRFLOWMATRIX_H
@@ -0,0 +1,50 @@
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Parallel.h"
+
+unsigned resolveThreads(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+void parallelFor(size_t count, unsigned threads, const std::function<void(unsigned, size_t)> &body) {
+    threads = resolveThreads(threads);
+    if (threads == 1 || count <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            body(0, i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error = nullptr;
+    std::mutex errorMutex;
+    auto worker = [&](unsigned w) {
+        size_t i;
+        while ((i = next.fetch_add(1)) < count) {
+            try {
+                body(w, i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (error == nullptr) error = std::current_exception();
+                next = count;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned w = 1; w < threads; w++) {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    if (error != nullptr) std::rethrow_exception(error);
+}
@@ -0,0 +1,29 @@
+#ifndef G16_3_PARALLEL_H
+#define G16_3_PARALLEL_H
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Resolves a requested number of worker threads.
+ *
+ * @param threads The requested number of threads, 0 for one per hardware thread.
+ * @return The number of threads to use, at least 1.
+ */
+unsigned resolveThreads(unsigned threads);
+
+/**
+ * @brief Runs a function for every item in [0, count) on a pool of worker threads.
+ *
+ * Items are handed out dynamically: every worker takes the next unprocessed item from a shared atomic counter as soon as it is
+ * free, so items of very different cost still keep all workers busy. The worker index passed to the function is stable for the
+ * whole call and lies in [0, resolveThreads(threads)), which lets each worker own private state indexed by it. With a single
+ * thread the items run in order on the calling thread. If any call throws, the remaining items are skipped and the first
+ * exception is rethrown once every worker has stopped.
+ *
+ * @param count The number of items.
+ * @param threads The number of worker threads, 0 for one per hardware thread.
+ * @param body The function to run, called as body(worker, item).
+ */
+void parallelFor(size_t count, unsigned threads, const std::function<void(unsigned, size_t)> &body);
+
+#endif //G16_3_PARALLEL_H
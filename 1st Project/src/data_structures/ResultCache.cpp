@@ -0,0 +1,83 @@
+#include <functional>
+#include "ResultCache.h"
+
+bool ResultKey::operator==(const ResultKey &other) const {
+    return source == other.source && sink == other.sink && query == other.query && version == other.version && costEpoch == other.costEpoch;
+}
+
+size_t ResultKeyHash::operator()(const ResultKey &key) const {
+    size_t h = std::hash<const Vertex *>()(key.source);
+    h = h * 31 + std::hash<const Vertex *>()(key.sink);
+    h = h * 31 + (size_t) key.query;
+    h = h * 31 + std::hash<unsigned long>()(key.version);
+    return h * 31 + std::hash<unsigned long>()(key.costEpoch);
+}
+
+ResultCache::ResultCache(size_t capacity): capacity(capacity) {}
+
+bool ResultCache::lookup(const ResultKey &key, std::pair<double, double> &result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    result = it->second->second;
+    hits++;
+    return true;
+}
+
+void ResultCache::insert(const ResultKey &key, const std::pair<double, double> &result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) return;
+    auto it = index.find(key);
+    if (it != index.end()) {
+        // Another thread computed the same result in the meantime
+        it->second->second = result;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    entries.emplace_front(key, result);
+    index.emplace(key, entries.begin());
+    evict();
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+}
+
+void ResultCache::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->capacity = capacity;
+    evict();
+}
+
+size_t ResultCache::getCapacity() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+size_t ResultCache::getSize() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+unsigned long ResultCache::getHits() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+unsigned long ResultCache::getMisses() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+void ResultCache::evict() {
+    while (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef G16_3_RESULTCACHE_H
+#define G16_3_RESULTCACHE_H
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include "VertexEdge.h"
+
+/**
+ * @brief Kind of query whose result is kept in a ResultCache.
+ */
+enum class CachedQuery { MaxFlow, MaxTrainsAtStation, MinCost };
+
+/**
+ * @brief Identifies a cached result: the stations of the query, its kind and the version of the graph it was computed on,
+ * plus the service costs it used for minimum-cost queries.
+ */
+struct ResultKey {
+    const Vertex *source;    // source station, or nullptr if the query has none
+    const Vertex *sink;      // sink station
+    CachedQuery query;
+    unsigned long version;   // version of the graph when the result was computed
+    unsigned long costEpoch = 0;    // service costs epoch of the graph for minimum-cost queries, 0 for the others
+
+    bool operator==(const ResultKey &other) const;
+};
+
+/**
+ * @brief Hash function of ResultKey.
+ */
+struct ResultKeyHash {
+    size_t operator()(const ResultKey &key) const;
+};
+
+/**
+ * @brief Bounded least-recently-used cache of query results, safe to use from several threads.
+ *
+ * Every result is a pair of values, the flow and, for minimum-cost queries, its cost. Entries are kept in a list ordered
+ * from the most to the least recently used, indexed by a hash map, so a lookup and an insertion take constant time and the
+ * least recently used entry is the one evicted when the cache is full. Since the version of the graph is part of the key,
+ * results of an older graph are never returned; they simply age out of the cache.
+ */
+class ResultCache {
+public:
+    /**
+     * @brief Creates an empty cache.
+     *
+     * @param capacity The maximum number of results kept, 0 to disable the cache.
+     */
+    explicit ResultCache(size_t capacity = 4096);
+
+    /**
+     * @brief Looks up a result and, if found, marks it as the most recently used.
+     *
+     * @param key The key of the result.
+     * @param result Receives the result if it is found.
+     * @return true if the result was found, false otherwise.
+     * Time Complexity: O(1) on average
+     */
+    bool lookup(const ResultKey &key, std::pair<double, double> &result);
+
+    /**
+     * @brief Stores a result as the most recently used, evicting the least recently used one if the cache is full.
+     *
+     * @param key The key of the result.
+     * @param result The result.
+     * Time Complexity: O(1) on average
+     */
+    void insert(const ResultKey &key, const std::pair<double, double> &result);
+
+    /**
+     * @brief Removes every result. The hit and miss counters are kept.
+     */
+    void clear();
+
+    /**
+     * @brief Changes the maximum number of results kept, evicting the least recently used ones if needed.
+     *
+     * @param capacity The new capacity, 0 to disable the cache.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @brief Gets the maximum number of results kept.
+     *
+     * @return The capacity of the cache.
+     */
+    size_t getCapacity();
+
+    /**
+     * @brief Gets the number of results currently kept.
+     *
+     * @return The size of the cache.
+     */
+    size_t getSize();
+
+    /**
+     * @brief Gets the number of lookups that found their result.
+     *
+     * @return The number of hits.
+     */
+    unsigned long getHits();
+
+    /**
+     * @brief Gets the number of lookups that did not find their result.
+     *
+     * @return The number of misses.
+     */
+    unsigned long getMisses();
+
+protected:
+    /**
+     * @brief Evicts the least recently used results until the cache holds at most its capacity.
+     */
+    void evict();
+
+    using Entry = std::pair<ResultKey, std::pair<double, double>>;
+
+    std::mutex mutex;                  // guards every member below
+    size_t capacity;
+    std::list<Entry> entries;          // results, from the most to the least recently used
+    std::unordered_map<ResultKey, std::list<Entry>::iterator, ResultKeyHash> index;    // position of each result in entries
+    unsigned long hits = 0;
+    unsigned long misses = 0;
+};
+
+#endif //G16_3_RESULTCACHE_H
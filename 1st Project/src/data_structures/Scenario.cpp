@@ -0,0 +1,92 @@
+#include "Scenario.h"
+
+Scenario::Scenario(std::shared_ptr<const FlowNetwork> network): network(std::move(network)) {
+    disabledStations.assign(this->network->getNumVertices(), false);
+    disabledArcs.assign(this->network->getNumArcs(), false);
+    changed.assign(this->network->getNumArcs(), false);
+}
+
+const FlowNetwork &Scenario::getNetwork() const {
+    return *network;
+}
+
+void Scenario::setArcCapacity(int a, Capacity value) {
+    if (capacities.empty()) {
+        capacities = network->getCapacities();
+    }
+    capacities[a] = value;
+    if (!changed[a]) {
+        changed[a] = true;
+        changedArcs.push_back(a);
+    }
+}
+
+bool Scenario::disableStation(const Vertex *station) {
+    int u = network->indexOf(station);
+    if (u == -1) return false;
+    disabledStations[u] = true;
+    for (int a = network->getArcsBegin(u); a < network->getArcsEnd(u); a++) {
+        for (int arc : {a, network->getReverse(a)}) {
+            disabledArcs[arc] = true;
+            setArcCapacity(arc, 0);
+        }
+    }
+    return true;
+}
+
+bool Scenario::disableSegment(const Vertex *a, const Vertex *b) {
+    int u = network->indexOf(a);
+    int v = network->indexOf(b);
+    if (u == -1 || v == -1) return false;
+    bool found = false;
+    for (int arc = network->getArcsBegin(u); arc < network->getArcsEnd(u); arc++) {
+        if (network->getHead(arc) != v) continue;
+        for (int x : {arc, network->getReverse(arc)}) {
+            disabledArcs[x] = true;
+            setArcCapacity(x, 0);
+        }
+        found = true;
+    }
+    return found;
+}
+
+bool Scenario::disableEdge(const Edge *e) {
+    int arc = network->arcOf(e);
+    if (arc == -1) return false;
+    for (int x : {arc, network->getReverse(arc)}) {
+        disabledArcs[x] = true;
+        setArcCapacity(x, 0);
+    }
+    return true;
+}
+
+bool Scenario::setSegmentCapacity(const Vertex *a, const Vertex *b, Capacity capacity) {
+    int u = network->indexOf(a);
+    int v = network->indexOf(b);
+    if (u == -1 || v == -1) return false;
+    bool found = false;
+    for (int arc = network->getArcsBegin(u); arc < network->getArcsEnd(u); arc++) {
+        if (network->getHead(arc) != v) continue;
+        for (int x : {arc, network->getReverse(arc)}) {
+            if (!disabledArcs[x]) setArcCapacity(x, capacity);
+        }
+        found = true;
+    }
+    return found;
+}
+
+bool Scenario::isStationDisabled(int v) const {
+    return disabledStations[v];
+}
+
+bool Scenario::isArcDisabled(int a) const {
+    return disabledArcs[a];
+}
+
+const std::vector<Capacity> *Scenario::getCapacities() const {
+    return capacities.empty() ? nullptr : &capacities;
+}
+
+const std::vector<int> &Scenario::getChangedArcs() const {
+    return changedArcs;
+}
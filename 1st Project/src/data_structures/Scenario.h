@@ -0,0 +1,120 @@
+#ifndef G16_3_SCENARIO_H
+#define G16_3_SCENARIO_H
+#include <memory>
+#include <vector>
+#include "FlowNetwork.h"
+
+/**
+ * @brief What-if overlay on a flow network: disabled stations, disabled segments and capacity overrides.
+ *
+ * A scenario never changes the network or the Graph it was built from. Disabled stations and arcs are kept as bitmasks, and the
+ * effective capacity of every arc is only materialized, by copying the capacities of the network, on the first change:
+ * an unchanged scenario shares the capacities of the network. Solvers see a scenario through FlowContext::setCapacities, so
+ * every algorithm that runs on a context (Edmonds-Karp, Dinic, push-relabel, minimum cuts, repairs, Gomory-Hu trees and
+ * pairwise flow matrices) respects it. Any number of scenarios can be evaluated side by side on the same network.
+ */
+class Scenario {
+public:
+    /**
+     * @brief Creates a scenario with no changes.
+     *
+     * @param network The network the scenario is layered on, kept alive by the scenario.
+     */
+    explicit Scenario(std::shared_ptr<const FlowNetwork> network);
+
+    /**
+     * @brief Gets the network the scenario is layered on.
+     *
+     * @return A reference to the network.
+     */
+    const FlowNetwork &getNetwork() const;
+
+    /**
+     * @brief Disables a station: every segment that reaches it gets no capacity, in both directions.
+     *
+     * @param station Pointer to the station.
+     * @return true if the station is part of the network, false otherwise.
+     * Time Complexity: O(deg(v)), plus O(E) on the first change of the scenario
+     */
+    bool disableStation(const Vertex *station);
+
+    /**
+     * @brief Disables every segment between two stations, in both directions.
+     *
+     * @param a Pointer to one station.
+     * @param b Pointer to the other station.
+     * @return true if at least one segment joins the two stations, false otherwise.
+     * Time Complexity: O(deg(a)), plus O(E) on the first change of the scenario
+     */
+    bool disableSegment(const Vertex *a, const Vertex *b);
+
+    /**
+     * @brief Disables one segment, in both directions, leaving any parallel segment between the same stations untouched.
+     *
+     * @param e Pointer to the edge of the segment, in either direction.
+     * @return true if the edge is part of the network, false otherwise.
+     * Time Complexity: O(deg(v)), with v the origin of the edge, plus O(E) on the first change of the scenario
+     */
+    bool disableEdge(const Edge *e);
+
+    /**
+     * @brief Overrides the capacity of every segment between two stations, in both directions.
+     *
+     * Disabled segments keep no capacity.
+     *
+     * @param a Pointer to one station.
+     * @param b Pointer to the other station.
+     * @param capacity The new capacity.
+     * @return true if at least one segment joins the two stations, false otherwise.
+     * Time Complexity: O(deg(a)), plus O(E) on the first change of the scenario
+     */
+    bool setSegmentCapacity(const Vertex *a, const Vertex *b, Capacity capacity);
+
+    /**
+     * @brief Checks if a station is disabled.
+     *
+     * @param v Index of the station in the network.
+     * @return true if the station is disabled, false otherwise.
+     */
+    bool isStationDisabled(int v) const;
+
+    /**
+     * @brief Checks if an arc is disabled, by itself or through one of its stations.
+     *
+     * @param a Index of the arc in the network.
+     * @return true if the arc is disabled, false otherwise.
+     */
+    bool isArcDisabled(int a) const;
+
+    /**
+     * @brief Gets the effective capacities of the arcs, to be passed to FlowContext::setCapacities.
+     *
+     * @return The capacities indexed by arc, or nullptr while the scenario has no changes.
+     */
+    const std::vector<Capacity> *getCapacities() const;
+
+    /**
+     * @brief Gets the arcs whose capacity differs from the network, in the order they were first changed.
+     *
+     * @return The changed arcs, as expected by FlowNetwork::repairMaxFlow.
+     */
+    const std::vector<int> &getChangedArcs() const;
+
+protected:
+    /**
+     * @brief Sets the effective capacity of an arc, materializing the capacities on the first change.
+     *
+     * @param a Index of the arc.
+     * @param value The new capacity.
+     */
+    void setArcCapacity(int a, Capacity value);
+
+    std::shared_ptr<const FlowNetwork> network;
+    std::vector<bool> disabledStations;     // one bit per station
+    std::vector<bool> disabledArcs;         // one bit per arc
+    std::vector<bool> changed;              // one bit per arc, set once the arc is in changedArcs
+    std::vector<int> changedArcs;
+    std::vector<Capacity> capacities;       // empty until the first change, then one entry per arc
+};
+
+#endif //G16_3_SCENARIO_H
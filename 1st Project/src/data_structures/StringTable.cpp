@@ -0,0 +1,18 @@
+#include "StringTable.h"
+
+uint32_t StringTable::intern(std::string_view s) {
+    auto it = codes.find(s);
+    if (it != codes.end()) return it->second;
+    uint32_t code = (uint32_t) strings.size();
+    strings.emplace_back(s);
+    codes.emplace(strings.back(), code);
+    return code;
+}
+
+const std::string &StringTable::at(uint32_t code) const {
+    return strings[code];
+}
+
+size_t StringTable::size() const {
+    return strings.size();
+}
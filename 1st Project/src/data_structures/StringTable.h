@@ -0,0 +1,48 @@
+#ifndef G16_3_STRINGTABLE_H
+#define G16_3_STRINGTABLE_H
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Table of interned strings, each identified by a small integer code.
+ *
+ * Equal strings always get the same code, so attributes repeated across many stations and segments (districts,
+ * municipalities, townships, lines and services) are stored once and compared as integers. Codes are dense, starting at 0,
+ * and references returned by at() stay valid for the lifetime of the table. Reading is safe from several threads as long as
+ * no string is being interned at the same time.
+ */
+class StringTable {
+public:
+    /**
+     * @brief Gets the code of a string, adding it to the table if it is not there yet.
+     *
+     * @param s The string.
+     * @return The code of the string.
+     * Time Complexity: O(|s|) on average
+     */
+    uint32_t intern(std::string_view s);
+
+    /**
+     * @brief Gets the string of a code.
+     *
+     * @param code A code returned by intern().
+     * @return The string.
+     */
+    const std::string &at(uint32_t code) const;
+
+    /**
+     * @brief Gets the number of strings in the table, which is also the first unused code.
+     *
+     * @return The number of strings.
+     */
+    size_t size() const;
+
+protected:
+    std::deque<std::string> strings;                        // string of each code, never moved once added
+    std::unordered_map<std::string_view, uint32_t> codes;   // code of each string, keyed by views into strings
+};
+
+#endif //G16_3_STRINGTABLE_H
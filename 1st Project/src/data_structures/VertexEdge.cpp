@@ -2,82 +2,88 @@
 
 /************************* Vertex  **************************/
 
-Vertex::Vertex(std::string name): name(name) {}
-Vertex::Vertex(std::string name,std::string district,std::string municipality,std::string township,std::string line): name(name),district(district),municipality(municipality),township(township),line(line){}
+Vertex::Vertex(uint32_t name,uint32_t district,uint32_t municipality,uint32_t township,uint32_t line,GraphStorage &storage):
+    name(name),district(district),municipality(municipality),township(township),line(line),storage(&storage){}
 
 Edge * Vertex::addEdge(Vertex *d, double w,std::string service) {
-    auto newEdge = new Edge(this, d, w,service);
+    return addEdge(d, w, storage->strings.intern(service));
+}
+
+Edge * Vertex::addEdge(Vertex *d, double w,uint32_t service) {
+    auto newEdge = storage->edges.create(this, d, w, service);
     adj.push_back(newEdge);
-    d->incoming.push_back(newEdge);
+    edgesChanged();
     return newEdge;
 }
 
-bool Vertex::removeEdge(std::string destName) {
+bool Vertex::removeEdge(Vertex *dest) {
     bool removedEdge = false;
     auto it = adj.begin();
     while (it != adj.end()) {
         Edge *edge = *it;
-        Vertex *dest = edge->getDest();
-        if (dest->getName() == destName) {
+        if (edge->getDest() == dest) {
             it = adj.erase(it);
-            // Also remove the corresponding edge from the incoming list
-            auto it2 = dest->incoming.begin();
-            while (it2 != dest->incoming.end()) {
-                if ((*it2)->getOrig()->getName() == name) {
-                    it2 = dest->incoming.erase(it2);
-                }
-                else {
-                    it2++;
-                }
-            }
-            delete edge;
+            storage->edges.destroy(edge);
             removedEdge = true; // allows for multiple edges to connect the same pair of vertices (multigraph)
         }
         else {
             it++;
         }
     }
+    if (removedEdge) edgesChanged();
     return removedEdge;
 }
 
-bool Vertex::operator<(Vertex & vertex) const {
-    return this->dist < vertex.dist;
+void Vertex::edgesChanged() {
+    storage->version++;
 }
 
-std::string Vertex::getName() const {
-    return this->name;
+const std::string &Vertex::getName() const {
+    return storage->strings.at(name);
 }
-std::string Vertex::getDistrict() const {
-    return this->district;
+
+int Vertex::getId() const {
+    return this->id;
 }
 
-std::string Vertex::getMunicipality() const {
-    return this->municipality;
+void Vertex::setId(int id) {
+    this->id = id;
+}
+const std::string &Vertex::getDistrict() const {
+    return storage->strings.at(district);
 }
 
-std::vector<Edge*> Vertex::getAdj() const {
-    return this->adj;
+const std::string &Vertex::getMunicipality() const {
+    return storage->strings.at(municipality);
+}
+
+const std::string &Vertex::getTownship() const {
+    return storage->strings.at(township);
+}
+
+const std::string &Vertex::getLine() const {
+    return storage->strings.at(line);
 }
 
-bool Vertex::isVisited() const {
-    return this->visited;
+uint32_t Vertex::getDistrictCode() const {
+    return district;
 }
 
-Edge *Vertex::getPath() const {
-    return this->path;
+uint32_t Vertex::getMunicipalityCode() const {
+    return municipality;
 }
 
-void Vertex::setVisited(bool visited) {
-    this->visited = visited;
+const StringTable &Vertex::getStrings() const {
+    return storage->strings;
 }
 
-void Vertex::setPath(Edge *path) {
-    this->path = path;
+const std::vector<Edge *> &Vertex::getAdj() const {
+    return this->adj;
 }
 
 /********************** Edge  ****************************/
 
-Edge::Edge(Vertex *orig, Vertex *dest, double w,std::string service): orig(orig), dest(dest), weight(w),service(service){}
+Edge::Edge(Vertex *orig, Vertex *dest, double w,uint32_t service): dest(dest), orig(orig), weight(w),service(service){}
 
 Vertex * Edge::getDest() const {
     return this->dest;
@@ -87,7 +93,16 @@ double Edge::getWeight() const {
     return this->weight;
 }
 
-std::string Edge::getService() const {
+void Edge::setWeight(double weight) {
+    this->weight = weight;
+    orig->edgesChanged();
+}
+
+const std::string &Edge::getService() const {
+    return orig->getStrings().at(service);
+}
+
+uint32_t Edge::getServiceCode() const {
     return this->service;
 }
 
@@ -99,14 +114,6 @@ Edge *Edge::getReverse() const {
     return this->reverse;
 }
 
-double Edge::getFlow() const {
-    return flow;
-}
-
 void Edge::setReverse(Edge *reverse) {
     this->reverse = reverse;
-}
-
-void Edge::setFlow(double flow) {
-    this->flow = flow;
 }
\ No newline at end of file
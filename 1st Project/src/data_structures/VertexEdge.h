@@ -1,12 +1,18 @@
 #ifndef G16_3_VERTEXEDGE_H
 #define G16_3_VERTEXEDGE_H
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <queue>
 #include <limits>
 #include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include "Arena.h"
+#include "StringTable.h"
 
 class Edge;
+struct GraphStorage;
 
 #define INF std::numeric_limits<double>::max()
 
@@ -18,85 +24,100 @@ public:
     /**
      * @brief Constructor for Vertex class.
      *
-     * @param name The name of the vertex.
+     * The name, district, municipality, township and line are given by their codes in the string table of the graph.
+     *
+     * @param name The code of the name of the vertex.
+     * @param district The code of the district of the vertex.
+     * @param municipality The code of the municipality of the vertex.
+     * @param township The code of the township of the vertex.
+     * @param line The code of the line of the vertex.
+     * @param storage The storage of the graph, which must outlive the vertex: its string table, the arena of its edges and its version.
      */
-    Vertex(std::string name);
+    Vertex(uint32_t name,uint32_t district,uint32_t municipality,uint32_t township,uint32_t line,GraphStorage &storage);
 
     /**
-     * @brief Constructor for Vertex class.
+     * @brief Gets the name of the vertex.
      *
-     * @param name The name of the vertex.
-     * @param district The district of the vertex.
-     * @param municipality The municipality of the vertex.
-     * @param township The township of the vertex.
-     * @param line The line of the vertex.
+     * @return The name of the vertex.
      */
-    Vertex(std::string name,std::string district,std::string municipality,std::string township,std::string line);
+    const std::string &getName() const;
 
     /**
-     * @brief Overloaded less-than operator for comparing vertices based on their 'dist' member variable.
+     * @brief Gets the dense integer identifier of the vertex.
      *
-     * @param vertex The vertex to be compared.
+     * The identifier is the position of the vertex in the vertex set of its Graph, assigned by Graph::addVertex and kept dense
+     * by Graph::removeVertex. All flow algorithms index their arrays by it.
      *
-     * @return true if the current vertex's 'dist' is less than the 'dist' of the input vertex, false otherwise.
+     * @return The identifier of the vertex, or -1 if it has not been added to a graph.
      */
-    bool operator<(Vertex & vertex) const;
+    int getId() const;
 
     /**
-     * @brief Gets the name of the vertex.
+     * @brief Sets the dense integer identifier of the vertex.
      *
-     * @return The name of the vertex.
+     * @param id The identifier to be set.
      */
-    std::string getName() const;
+    void setId(int id);
 
     /**
      * @brief Gets the district of the vertex.
      *
      * @return The district of the vertex.
      */
-    std::string getDistrict() const;
+    const std::string &getDistrict() const;
 
     /**
      * @brief Gets the municipality of the vertex.
      *
      * @return The municipality of the vertex.
      */
-    std::string getMunicipality() const;
+    const std::string &getMunicipality() const;
 
+    /**
+     * @brief Gets the township of the vertex.
+     *
+     * @return The township of the vertex.
+     */
+    const std::string &getTownship() const;
 
     /**
-     * @brief Gets the adjacency list of the vertex.
+     * @brief Gets the line of the vertex.
      *
-     * @return A vector of pointers to edges representing the adjacency list of the vertex.
+     * @return The line of the vertex.
      */
-    std::vector<Edge *> getAdj() const;
+    const std::string &getLine() const;
 
     /**
-     * @brief Checks if the vertex has been visited.
+     * @brief Gets the code of the district of the vertex in its string table.
      *
-     * @return true if the vertex has been visited, false otherwise.
+     * @return The code of the district.
      */
-    bool isVisited() const;
+    uint32_t getDistrictCode() const;
+
     /**
-     * @brief Gets the path associated with the vertex.
+     * @brief Gets the code of the municipality of the vertex in its string table.
      *
-     * @return A pointer to the edge representing the path associated with the vertex.
+     * @return The code of the municipality.
      */
-    Edge *getPath() const;
+    uint32_t getMunicipalityCode() const;
 
     /**
-     * @brief Sets the visited status of the vertex.
+     * @brief Gets the string table that holds the attributes of the vertex and the services of its edges.
      *
-     * @param visited The visited status to be set.
+     * @return The string table.
      */
-    void setVisited(bool visited);
+    const StringTable &getStrings() const;
 
     /**
-     * @brief Sets the path associated with the vertex.
+     * @brief Gets the adjacency list of the vertex.
+     *
+     * The list is returned by reference and is invalidated by addEdge and removeEdge on this vertex, so loops that change
+     * the edges of the vertex must not iterate over it directly.
      *
-     * @param path A pointer to the edge representing the path to be set.
+     * @return A vector of pointers to edges representing the adjacency list of the vertex.
      */
-    void setPath(Edge *path);
+    const std::vector<Edge *> &getAdj() const;
+
     /**
      * @brief Adds an edge from the current vertex to a destination vertex with a given weight and service.
      *
@@ -109,28 +130,41 @@ public:
     Edge * addEdge(Vertex *dest, double w,std::string service);
 
     /**
-     * @brief Adds an edge from the current vertex to a destination vertex with a given weight and service.
+     * @brief Adds an edge from the current vertex to a destination vertex with a service already interned.
      *
      * @param d Pointer to the destination vertex.
      * @param w Weight of the edge.
-     * @param service The service associated with the edge.
+     * @param service The code of the service in the string table of the vertex.
      *
      * @return Pointer to the newly created edge.
      */
-    bool removeEdge(std::string destName);
+    Edge * addEdge(Vertex *dest, double w,uint32_t service);
+
+    /**
+     * @brief Removes every edge from the current vertex to a destination vertex.
+     *
+     * @param dest Pointer to the destination vertex.
+     *
+     * @return true if at least one edge was removed, false otherwise.
+     */
+    bool removeEdge(Vertex *dest);
 protected:
-    std::string name;
-    std::string district;
-    std::string municipality;
-    std::string township;
-    std::string line;
+    friend class Edge;
+
+    /**
+     * @brief Increments the version of the owning graph after a change to the edges of the vertex.
+     */
+    void edgesChanged();
+
+    // Only the adjacency list and the identifier are read by traversals, the attributes are codes and the rest is one pointer
     std::vector<Edge *> adj;
-    bool visited = false;
-    bool processing = false;
-    unsigned int indegree;
-    double dist = 0;
-    Edge *path = nullptr;
-    std::vector<Edge *> incoming;
+    int id = -1;
+    uint32_t name;                  // codes in the string table of storage
+    uint32_t district;
+    uint32_t municipality;
+    uint32_t township;
+    uint32_t line;
+    GraphStorage *storage;
 };
 
 /********************** Edge  ****************************/
@@ -143,9 +177,9 @@ public:
      * @param orig Pointer to the origin vertex of the edge.
      * @param dest Pointer to the destination vertex of the edge.
      * @param w Weight of the edge.
-     * @param service The service associated with the edge.
+     * @param service The code of the service associated with the edge in the string table of its vertices.
      */
-    Edge(Vertex *orig, Vertex *dest, double w,std::string service);
+    Edge(Vertex *orig, Vertex *dest, double w,uint32_t service);
 
     /**
      * @brief Gets the destination vertex of the edge.
@@ -161,12 +195,26 @@ public:
      */
     double getWeight() const;
 
+    /**
+     * @brief Sets the weight of the edge, which changes the version of the graph.
+     *
+     * @param weight The weight to be set.
+     */
+    void setWeight(double weight);
+
     /**
      * @brief Gets the service associated with the edge.
      *
      * @return The service associated with the edge.
      */
-    std::string getService() const;
+    const std::string &getService() const;
+
+    /**
+     * @brief Gets the code of the service associated with the edge in the string table of its vertices.
+     *
+     * @return The code of the service.
+     */
+    uint32_t getServiceCode() const;
 
     /**
      * @brief Gets the origin vertex of the edge.
@@ -182,33 +230,27 @@ public:
      */
     Edge *getReverse() const;
 
-    /**
-     * @brief Gets the flow of the edge.
-     *
-     * @return The flow of the edge.
-     */
-    double getFlow() const;
-
     /**
      * @brief Sets the reverse edge associated with this edge.
      *
      * @param reverse Pointer to the reverse edge to be set.
      */
     void setReverse(Edge *reverse);
-
-    /**
-     * @brief Sets the flow of the edge.
-     *
-     * @param flow The flow to be set.
-     */
-    void setFlow(double flow);
 protected:
     Vertex * dest;
-    double weight;
-    std::string service;
     Vertex *orig;
     Edge *reverse = nullptr;
-    double flow = 0;
+    double weight;
+    uint32_t service;       // code in the string table of the vertices
+};
+
+/**
+ * @brief State that the vertices of a graph share with the graph and with its copies.
+ */
+struct GraphStorage {
+    StringTable strings;                    // names and attributes of the vertices and services of the edges
+    Arena<Edge> edges{4096};                // owns every edge
+    std::atomic<unsigned long> version{0};  // incremented on every change, see Graph::getVersion
 };
 
 #endif //G16_3_VERTEXEDGE_H
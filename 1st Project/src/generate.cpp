@@ -0,0 +1,51 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include "io/NetworkGenerator.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    GeneratorOptions options;
+    string output = ".";
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++) {
+        string arg = argv[i];
+        if (i + 1 == argc) {
+            valid = false;
+            break;
+        }
+        string value = argv[++i];
+        if (arg == "--stations") {
+            options.stations = atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = (unsigned) strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--line-length") {
+            options.lineLength = atoi(value.c_str());
+        } else if (arg == "--output") {
+            output = value;
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid || options.stations < 2 || options.lineLength < 2) {
+        cerr << "Usage: " << argv[0] << " --stations N [--seed N] [--line-length N] [--output DIR]" << endl;
+        return 1;
+    }
+
+    ofstream stations(output + "/stations.csv");
+    ofstream network(output + "/network.csv");
+    if (!stations || !network) {
+        cerr << "Error writing to " << output << endl;
+        return 1;
+    }
+    size_t segments = generateNetwork(options, stations, network);
+    stations.close();
+    network.close();
+    if (!stations || !network) {
+        cerr << "Error writing to " << output << endl;
+        return 1;
+    }
+    cerr << "Generated " << options.stations << " stations and " << segments << " segments in " << output << endl;
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+#include "../data_structures/Parallel.h"
+#include "BatchQueries.h"
+#include "RailwayReader.h"
+
+namespace {
+
+enum class QueryType { Between, AtStation, MinCost, TopDistricts, Invalid };
+
+struct Query {
+    size_t id = 0;
+    QueryType type = QueryType::Invalid;
+    std::string name;                   // query type as written in the input
+    std::vector<std::string> args;
+    Vertex *from = nullptr;
+    Vertex *to = nullptr;
+    int k = 0;
+    double flow = 0.0;
+    double cost = 0.0;
+    std::string error;
+};
+
+QueryType queryType(const std::string &name) {
+    if (name == "between") return QueryType::Between;
+    if (name == "at_station") return QueryType::AtStation;
+    if (name == "min_cost") return QueryType::MinCost;
+    if (name == "top_districts") return QueryType::TopDistricts;
+    return QueryType::Invalid;
+}
+
+/**
+ * @brief Parses a query line and resolves its stations.
+ */
+void parseQuery(Graph &railway, std::string_view line, std::vector<std::string_view> &fields, Query &query) {
+    parse_csv_line(line, fields);
+    query.name.assign(fields[0]);
+    query.args.assign(fields.begin() + 1, fields.end());
+    query.type = queryType(query.name);
+
+    size_t expected = query.type == QueryType::Between || query.type == QueryType::MinCost ? 2 : 1;
+    if (query.type == QueryType::Invalid) {
+        query.error = "Unknown query type: " + query.name;
+        return;
+    }
+    if (query.args.size() != expected) {
+        query.error = "Expected " + std::to_string(expected) + " argument(s)";
+        query.type = QueryType::Invalid;
+        return;
+    }
+
+    if (query.type == QueryType::TopDistricts) {
+        char *end;
+        long k = std::strtol(query.args[0].c_str(), &end, 10);
+        if (query.args[0].empty() || *end != '\0' || k <= 0 || k > std::numeric_limits<int>::max()) {
+            query.error = "Invalid number of districts: " + query.args[0];
+            query.type = QueryType::Invalid;
+            return;
+        }
+        query.k = (int) k;
+        return;
+    }
+
+    query.from = railway.findVertex(query.args[0]);
+    if (expected == 2) query.to = railway.findVertex(query.args[1]);
+    for (size_t i = 0; i < expected; i++) {
+        if ((i == 0 ? query.from : query.to) == nullptr) {
+            query.error = "Unknown station: " + query.args[i];
+            query.type = QueryType::Invalid;
+            return;
+        }
+    }
+}
+
+void writeCsvField(std::ostream &out, const std::string &field) {
+    if (field.find_first_of(",\"\n") == std::string::npos) {
+        out << field;
+        return;
+    }
+    out << '"';
+    for (char c : field) {
+        if (c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+void writeJsonString(std::ostream &out, const std::string &s) {
+    out << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if ((unsigned char) c < 0x20) {
+                    const char *hex = "0123456789abcdef";
+                    out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+void writeCsvRow(std::ostream &out, const Query &query, const std::string &from, const std::string &to, int rank, const std::string &flow,
+                 const std::string &cost) {
+    out << query.id << ',';
+    writeCsvField(out, query.name);
+    out << ',';
+    writeCsvField(out, from);
+    out << ',';
+    writeCsvField(out, to);
+    out << ',';
+    if (rank > 0) out << rank;
+    out << ',' << flow << ',' << cost << ',';
+    writeCsvField(out, query.error);
+    out << '\n';
+}
+
+std::string number(double value) {
+    std::string s = std::to_string(value);      // fixed notation, trailing zeros removed below
+    s.erase(s.find_last_not_of('0') + 1);
+    if (s.back() == '.') s.pop_back();
+    return s;
+}
+
+void writeCsv(std::ostream &out, const Query &query, const std::vector<std::pair<std::string, double>> &districts) {
+    if (!query.error.empty()) {
+        writeCsvRow(out, query, query.args.empty() ? "" : query.args[0], query.args.size() < 2 ? "" : query.args[1], 0, "", "");
+        return;
+    }
+    switch (query.type) {
+        case QueryType::Between:
+            writeCsvRow(out, query, query.args[0], query.args[1], 0, number(query.flow), "");
+            break;
+        case QueryType::AtStation:
+            writeCsvRow(out, query, query.args[0], "", 0, number(query.flow), "");
+            break;
+        case QueryType::MinCost:
+            writeCsvRow(out, query, query.args[0], query.args[1], 0, number(query.flow), number(query.cost));
+            break;
+        case QueryType::TopDistricts:
+            for (int i = 0; i < query.k && i < (int) districts.size(); i++) {
+                writeCsvRow(out, query, districts[i].first, "", i + 1, number(districts[i].second), "");
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void writeJson(std::ostream &out, const Query &query, const std::vector<std::pair<std::string, double>> &districts) {
+    out << "{\"id\":" << query.id << ",\"query\":";
+    writeJsonString(out, query.name);
+    if (!query.error.empty()) {
+        out << ",\"error\":";
+        writeJsonString(out, query.error);
+    } else if (query.type == QueryType::AtStation) {
+        out << ",\"station\":";
+        writeJsonString(out, query.args[0]);
+        out << ",\"flow\":" << number(query.flow);
+    } else if (query.type == QueryType::TopDistricts) {
+        out << ",\"k\":" << query.k << ",\"districts\":[";
+        for (int i = 0; i < query.k && i < (int) districts.size(); i++) {
+            out << (i == 0 ? "" : ",") << "{\"district\":";
+            writeJsonString(out, districts[i].first);
+            out << ",\"flow\":" << number(districts[i].second) << '}';
+        }
+        out << ']';
+    } else {
+        out << ",\"from\":";
+        writeJsonString(out, query.args[0]);
+        out << ",\"to\":";
+        writeJsonString(out, query.args[1]);
+        out << ",\"flow\":" << number(query.flow);
+        if (query.type == QueryType::MinCost) out << ",\"cost\":" << number(query.cost);
+    }
+    out << "}\n";
+}
+
+}
+
+size_t runBatch(Graph &railway, std::istream &in, std::ostream &out, const BatchOptions &options) {
+    size_t chunkSize = options.chunkSize == 0 ? 1 : options.chunkSize;
+    std::vector<Query> chunk;
+    std::vector<size_t> parallel;
+    std::vector<std::string_view> fields;
+    std::vector<std::pair<std::string, double>> districts;
+    bool rankedDistricts = false;
+    size_t nextId = 1;
+    size_t errors = 0;
+    std::string line;
+
+    if (options.format == BatchFormat::Csv) {
+        out << "id,query,from,to,rank,flow,cost,error\n";
+    }
+
+    bool done = false;
+    while (!done) {
+        chunk.clear();
+        parallel.clear();
+        while (chunk.size() < chunkSize) {
+            if (!std::getline(in, line)) {
+                done = true;
+                break;
+            }
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            chunk.emplace_back();
+            Query &query = chunk.back();
+            query.id = nextId++;
+            parseQuery(railway, line, fields, query);
+            if (query.type == QueryType::Between || query.type == QueryType::AtStation || query.type == QueryType::MinCost) {
+                parallel.push_back(chunk.size() - 1);
+            }
+        }
+
+        // Max-flow and min-cost queries only read the graph, so they run across threads
+        parallelFor(parallel.size(), options.threads, [&](unsigned, size_t i) {
+            Query &query = chunk[parallel[i]];
+            try {
+                if (query.type == QueryType::Between) {
+                    query.flow = railway.maxFlow(query.from, query.to, options.algorithm);
+                } else if (query.type == QueryType::AtStation) {
+                    query.flow = railway.getMaxTrainsAtStation(query.from);
+                } else {
+                    std::pair<double, double> result = railway.minCostTrains(query.from, query.to);
+                    query.flow = result.first;
+                    query.cost = result.second;
+                }
+            } catch (const std::runtime_error &e) {
+                query.error = e.what();
+            }
+        });
+
+        // The district ranking is computed once, by the first query that needs it
+        for (Query &query : chunk) {
+            try {
+                if (query.type == QueryType::TopDistricts && !rankedDistricts) {
+                    districts = railway.rankDistricts(options.algorithm);
+                    rankedDistricts = true;
+                }
+            } catch (const std::runtime_error &e) {
+                query.error = e.what();
+            }
+            if (!query.error.empty()) errors++;
+            if (options.format == BatchFormat::Json) {
+                writeJson(out, query, districts);
+            } else {
+                writeCsv(out, query, districts);
+            }
+        }
+        out.flush();
+    }
+    return errors;
+}
@@ -0,0 +1,47 @@
+#ifndef G16_3_BATCHQUERIES_H
+#define G16_3_BATCHQUERIES_H
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include "../data_structures/Graph.h"
+
+/**
+ * @brief Output format of the results of a batch of queries.
+ */
+enum class BatchFormat { Csv, Json };
+
+/**
+ * @brief Options of a batch run.
+ */
+struct BatchOptions {
+    BatchFormat format = BatchFormat::Csv;
+    FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp;   // algorithm of the max trains between stations queries
+    unsigned threads = 0;       // worker threads of the between and min_cost queries, 0 for one per hardware thread
+    size_t chunkSize = 1024;    // queries read, answered and written at a time
+};
+
+/**
+ * @brief Answers a stream of queries against a railway graph without any interaction, one query per line.
+ *
+ * Each line is a CSV record whose first field is the query type:
+ *  - between,<station>,<station>      maximum number of trains between two stations
+ *  - at_station,<station>             maximum number of trains that can simultaneously arrive at a station
+ *  - min_cost,<station>,<station>     maximum number of trains between two stations and their cost
+ *  - top_districts,<k>                the k districts with the highest accumulated maximum flow
+ * Empty lines and lines starting with '#' are ignored.
+ *
+ * Queries are processed in chunks: the between, at_station and min_cost queries of a chunk run in parallel, since they
+ * only read the graph, top_districts runs in order, and the results of the chunk are then written and flushed in input order.
+ * With BatchFormat::Csv the output starts with the header id,query,from,to,rank,flow,cost,error and every top_districts
+ * query writes one row per district; with BatchFormat::Json every query writes one JSON object per line. A malformed query
+ * or an unknown station produces an error result and does not stop the batch.
+ *
+ * @param railway The graph the queries are answered on.
+ * @param in The stream of queries.
+ * @param out The stream the results are written to.
+ * @param options The output format, algorithm, number of threads and chunk size.
+ * @return The number of queries that produced an error.
+ */
+size_t runBatch(Graph &railway, std::istream &in, std::ostream &out, const BatchOptions &options);
+
+#endif //G16_3_BATCHQUERIES_H
@@ -0,0 +1,61 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Error opening " + path);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        throw std::runtime_error("Error reading " + path);
+    }
+    size = (size_t) st.st_size;
+    if (size > 0) {
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Error mapping " + path);
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char *>(mapping);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap(const_cast<char *>(data), size);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) {
+    std::ifstream fin(path, std::ios::binary);
+    if (!fin.is_open()) {
+        throw std::runtime_error("Error opening " + path);
+    }
+    std::ostringstream contents;
+    contents << fin.rdbuf();
+    buffer = contents.str();
+    data = buffer.data();
+    size = buffer.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+std::string_view MappedFile::getData() const {
+    return std::string_view(data, size);
+}
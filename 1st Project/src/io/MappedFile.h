@@ -0,0 +1,44 @@
+#ifndef G16_3_MAPPEDFILE_H
+#define G16_3_MAPPEDFILE_H
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where the platform supports it.
+ *
+ * On POSIX systems the file is mapped with mmap, so its contents are paged in on demand and never copied into a buffer.
+ * On other platforms it falls back to reading the file into memory once. Either way the contents stay valid, and every
+ * std::string_view taken from them stays valid, for the lifetime of the object.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Opens and maps a file.
+     *
+     * @param path The path of the file.
+     * @throw std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string &path);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Gets the contents of the file.
+     *
+     * @return A view of the whole file.
+     */
+    std::string_view getData() const;
+
+protected:
+    const char *data = nullptr;
+    size_t size = 0;
+    std::string buffer;     // contents of the file when it could not be mapped
+};
+
+#endif //G16_3_MAPPEDFILE_H
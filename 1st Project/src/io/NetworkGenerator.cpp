@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "NetworkGenerator.h"
+
+/**
+ * @brief Gets the name of a generated station.
+ *
+ * @param id The number of the station.
+ * @return The name of the station.
+ */
+static std::string stationName(int id) {
+    return "Station " + std::to_string(id);
+}
+
+size_t generateNetwork(const GeneratorOptions &options, std::ostream &stations, std::ostream &network) {
+    std::mt19937 random(options.seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::discrete_distribution<int> branchCapacity({55, 30, 15});   // capacities 2, 4 and 6, roughly as in the dataset
+    int lineLength = std::max(2, options.lineLength);
+    int perMunicipality = std::max(1, options.stationsPerMunicipality);
+    int perDistrict = std::max(1, options.stationsPerDistrict);
+
+    std::vector<int> degree;
+    std::vector<int> junctions;     // stations with three or more segments
+    size_t segments = 0;
+    auto connect = [&](int a, int b, int capacity, const char *service) {
+        network << stationName(a) << ',' << stationName(b) << ',' << capacity << ',' << service << '\n';
+        for (int v : {a, b}) {
+            if (++degree[v] == 3) junctions.push_back(v);
+        }
+        segments++;
+    };
+
+    stations << "Name,District,Municipality,Township,Line\n";
+    network << "Station_A,Station_B,Capacity,Service\n";
+    int created = 0;
+    for (int line = 1; created < options.stations; line++) {
+        bool trunk = line % 10 == 1;
+        std::uniform_int_distribution<int> lengths(lineLength / 2, lineLength + lineLength / 2);
+        int length = std::min(lengths(random) * (trunk ? 2 : 1), options.stations - created);
+
+        int capacity;
+        const char *service;
+        if (trunk) {
+            capacity = 6 + 2 * std::uniform_int_distribution<int>(0, 2)(random);
+            service = chance(random) < 0.5 ? "ALFA PENDULAR" : "STANDARD";
+        } else {
+            capacity = 2 + 2 * branchCapacity(random);
+            service = chance(random) < 0.05 ? "ALFA PENDULAR" : "STANDARD";
+        }
+
+        // Every line but the first one branches off the existing network
+        int lineStart = created;
+        int previous = -1;
+        if (created > 0) {
+            if (!junctions.empty() && chance(random) < options.hubProbability) {
+                previous = junctions[std::uniform_int_distribution<size_t>(0, junctions.size() - 1)(random)];
+            } else {
+                previous = std::uniform_int_distribution<int>(0, created - 1)(random);
+            }
+        }
+
+        int neighbour = -1;     // the only station the last one of the line is connected to
+        for (int k = 0; k < length; k++) {
+            int id = created++;
+            degree.push_back(0);
+            int municipality = id / perMunicipality;
+            stations << stationName(id) << ",DISTRICT " << id / perDistrict << ",MUNICIPALITY " << municipality
+                     << ",Township " << municipality << ",Linha " << line << '\n';
+            if (previous != -1) connect(previous, id, capacity, service);
+            neighbour = previous;
+            previous = id;
+        }
+
+        // Close a loop with an older station close to the one the line started from. The junction a one-station line
+        // branched from is skipped, as connecting to it again would only add a parallel segment
+        if (lineStart > 0 && chance(random) < options.loopProbability) {
+            int nearest = std::max(0, lineStart - 20 * lineLength);
+            int last = lineStart - 1;
+            if (neighbour >= nearest && neighbour <= last) last--;
+            if (last >= nearest) {
+                int target = std::uniform_int_distribution<int>(nearest, last)(random);
+                if (neighbour >= nearest && target >= neighbour) target++;
+                connect(previous, target, capacity, service);
+            }
+        }
+    }
+    return segments;
+}
@@ -0,0 +1,38 @@
+#ifndef G16_3_NETWORKGENERATOR_H
+#define G16_3_NETWORKGENERATOR_H
+#include <cstddef>
+#include <ostream>
+
+/**
+ * @brief Parameters of a synthetic railway network.
+ */
+struct GeneratorOptions {
+    int stations = 1000;                // number of stations
+    unsigned seed = 16;                 // seed of the random generator, the same seed always gives the same network
+    int lineLength = 40;                // average number of stations of a line, trunk lines are twice as long
+    int stationsPerMunicipality = 4;    // consecutive stations that share a municipality and township
+    int stationsPerDistrict = 30;       // consecutive stations that share a district
+    double hubProbability = 0.6;        // probability that a new line branches off an existing junction rather than any station
+    double loopProbability = 0.3;       // probability that a new line ends at a nearby existing station, closing a loop
+};
+
+/**
+ * @brief Writes a synthetic railway network in the format read by readStations() and readNetwork().
+ *
+ * The network is grown one line at a time. The first line starts from scratch, and every other one branches off an
+ * existing station, usually a junction that already has three or more segments, so lines meet at a few hubs as in a real
+ * network. A line runs through its own new stations and may end at a nearby older station, closing a loop. Every tenth
+ * line is a trunk line: twice as long, with capacities of 6 to 10 and often served by ALFA PENDULAR trains, while the other
+ * lines have capacities of 2 to 6 and mostly STANDARD service. Stations are numbered in the order they are created, which
+ * keeps neighbouring stations close in the numbering, and consecutive blocks of stations form the municipalities and the
+ * districts. The network is always connected.
+ *
+ * @param options The parameters of the network.
+ * @param stations The stream the stations file is written to, with the header Name,District,Municipality,Township,Line.
+ * @param network The stream the network file is written to, with the header Station_A,Station_B,Capacity,Service.
+ * @return The number of segments written.
+ * Time Complexity: O(V)
+ */
+size_t generateNetwork(const GeneratorOptions &options, std::ostream &stations, std::ostream &network);
+
+#endif //G16_3_NETWORKGENERATOR_H
@@ -0,0 +1,128 @@
+#include <cstdlib>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "RailwaySnapshot.h"
+#include "RailwayReader.h"
+
+/**
+ * @brief Takes the next line from a block of text.
+ *
+ * @param rest The text still to be read, advanced past the line and its terminator.
+ * @param line Output view of the line, without "\n" or "\r\n".
+ * @return true if a line was read, false if the text is exhausted.
+ */
+static bool nextLine(std::string_view &rest, std::string_view &line) {
+    if (rest.empty()) return false;
+    size_t end = rest.find('\n');
+    if (end == std::string_view::npos) {
+        line = rest;
+        rest = std::string_view();
+    } else {
+        line = rest.substr(0, end);
+        rest.remove_prefix(end + 1);
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses a capacity field.
+ *
+ * @param field The text of the field.
+ * @param value Output value.
+ * @return true if the whole field is a number, false otherwise.
+ */
+static bool parseCapacity(std::string_view field, double &value) {
+    char buffer[64];
+    if (field.empty() || field.size() >= sizeof(buffer)) return false;
+    field.copy(buffer, field.size());
+    buffer[field.size()] = '\0';
+    char *end;
+    value = std::strtod(buffer, &end);
+    return end == buffer + field.size();
+}
+
+void parse_csv_line(std::string_view line, std::vector<std::string_view> &fields) {
+    fields.clear();
+    size_t i = 0;
+    while (true) {
+        if (i < line.size() && line[i] == '"') {
+            size_t close = line.find('"', i + 1);
+            if (close == std::string_view::npos) close = line.size();
+            fields.push_back(line.substr(i + 1, close - i - 1));
+            i = line.find(',', close);
+        } else {
+            size_t comma = line.find(',', i);
+            fields.push_back(line.substr(i, comma == std::string_view::npos ? std::string_view::npos : comma - i));
+            i = comma;
+        }
+        if (i == std::string_view::npos) break;
+        i++;
+    }
+}
+
+void readStations(Graph& railway, const std::string &path) {
+    MappedFile file(path);
+    std::string_view rest = file.getData();
+    std::string_view line;
+    std::vector<std::string_view> curr;
+    StringTable &strings = railway.getStrings();
+    nextLine(rest, line); // header
+    while (nextLine(rest, line)) {
+        if (line.empty()) continue;
+        parse_csv_line(line, curr);
+        if (curr.size() < 5) {
+            throw std::runtime_error("Malformed line in " + path + ": " + std::string(line));
+        }
+        railway.addVertex(strings.intern(curr[0]), strings.intern(curr[1]), strings.intern(curr[2]), strings.intern(curr[3]), strings.intern(curr[4])); // ignored if repeated
+    }
+}
+
+void readNetwork(Graph& railway, const std::string &path) {
+    MappedFile file(path);
+    std::string_view rest = file.getData();
+    std::string_view line;
+    std::vector<std::string_view> curr;
+    StringTable &strings = railway.getStrings();
+    int lineNumber = 1;
+    nextLine(rest, line); // header
+    while (nextLine(rest, line)) {
+        lineNumber++;
+        if (line.empty()) continue;
+        parse_csv_line(line, curr);
+        double capacity;
+        if (curr.size() < 4 || !parseCapacity(curr[2], capacity)) {
+            throw std::runtime_error("Malformed line in " + path + ": " + std::string(line));
+        }
+        // The flow solvers would otherwise truncate it, and disagree with the min-cost solver, which keeps doubles
+        if (!isExactCapacity<Capacity>(capacity)) {
+            throw std::runtime_error("Capacity not supported by the G16_3_CAPACITY type at line " + std::to_string(lineNumber) + " of " + path + ": " + std::string(line));
+        }
+        Vertex* stationA = railway.findVertex(curr[0]);
+        Vertex* stationB = railway.findVertex(curr[1]);
+        if (stationA == nullptr || stationB == nullptr) {
+            throw std::runtime_error("Unknown station in " + path + ": " + std::string(line));
+        }
+        railway.addBidirectionalEdge(stationA, stationB, capacity, strings.intern(curr[3]));
+    }
+}
+
+void read(Graph& railway){
+    const std::string stationsPath = "../dataset/stations.csv";
+    const std::string networkPath = "../dataset/network.csv";
+    const std::string snapshotPath = "../dataset/railway.snapshot";
+
+    uint64_t stamp = snapshotStamp({stationsPath, networkPath});
+    if (readSnapshot(railway, snapshotPath, stamp)) return;
+
+    readStations(railway, stationsPath);
+    readNetwork(railway, networkPath);
+    if (stamp == 0) return;
+    try {
+        writeSnapshot(railway, snapshotPath, stamp);
+    } catch (const std::runtime_error &) {
+        // The dataset directory may be read-only: the next run simply parses the CSV files again
+    }
+}
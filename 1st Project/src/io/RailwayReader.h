@@ -0,0 +1,55 @@
+#ifndef G16_3_RAILWAYREADER_H
+#define G16_3_RAILWAYREADER_H
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../data_structures/Graph.h"
+
+/**
+ * @brief Splits a line of CSV (Comma-Separated Values) into fields, without copying.
+ *
+ * Every field is a view into the line itself. Fields enclosed in double quotes are treated as a single field, even if they
+ * contain commas, and the view then covers only the text between the quotes.
+ *
+ * @param line The CSV line to be parsed, without its line terminator.
+ * @param fields Output vector, cleared and filled with one view per field. Reusing it across lines avoids any allocation.
+ */
+void parse_csv_line(std::string_view line, std::vector<std::string_view> &fields);
+
+/**
+ * @brief Reads station information from a CSV file and adds one vertex per station to a Graph.
+ *
+ * The file is memory-mapped and tokenized in place with parse_csv_line(). Each line represents a station with its name,
+ * district, municipality, township and line. The header line is skipped, and repeated station names are ignored.
+ *
+ * @param railway A reference to the Graph object to which the Vertex objects will be added.
+ * @param path The path of the stations file.
+ * @throw std::runtime_error If the file cannot be opened or a line has fewer than five fields.
+ */
+void readStations(Graph& railway, const std::string &path = "../dataset/stations.csv");
+
+/**
+ * @brief Reads network information from a CSV file and adds one bidirectional edge per segment to a Graph.
+ *
+ * The file is memory-mapped and tokenized in place with parse_csv_line(). Each line represents a segment between two stations,
+ * with its capacity and service. Stations are looked up through the name index of the Graph, so readStations() must run first.
+ *
+ * @param railway A reference to the Graph object to be updated with network information.
+ * @param path The path of the network file.
+ * @throw std::runtime_error If the file cannot be opened, a line is malformed, it refers to an unknown station or its capacity
+ * cannot be held exactly by Capacity, like a fractional capacity when G16_3_CAPACITY is an integral type.
+ */
+void readNetwork(Graph& railway, const std::string &path = "../dataset/network.csv");
+
+/**
+ * @brief Reads railway information from stations.csv and network.csv into a Graph.
+ *
+ * A binary snapshot of the graph is kept next to the CSV files in railway.snapshot. When it is up to date with both files
+ * it is memory-mapped and loaded instead of parsing them; otherwise the files are parsed and the snapshot is rewritten.
+ *
+ * @param railway A reference to the Graph object to be updated with railway information.
+ * @throw std::runtime_error If the stations.csv or network.csv files cannot be read.
+ */
+void read(Graph& railway);
+
+#endif //G16_3_RAILWAYREADER_H
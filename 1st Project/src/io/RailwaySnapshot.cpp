@@ -0,0 +1,258 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include "MappedFile.h"
+#include "RailwaySnapshot.h"
+
+namespace {
+
+const char MAGIC[8] = {'G', '1', '6', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t FORMAT_VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const uint32_t NO_ARC = 0xFFFFFFFF;
+const int STATION_FIELDS = 5;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t stamp;
+    uint32_t numStrings;
+    uint32_t stringBytes;
+    uint32_t numStations;
+    uint32_t numArcs;
+};
+
+static_assert(sizeof(SnapshotHeader) % sizeof(double) == 0, "the capacity section must stay aligned");
+
+/**
+ * @brief Interns strings into the string table of a snapshot.
+ */
+class StringTableWriter {
+public:
+    uint32_t intern(const std::string &s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) return it->second;
+        uint32_t id = (uint32_t) offsets.size() - 1;
+        ids.emplace(s, id);
+        bytes += s;
+        offsets.push_back((uint32_t) bytes.size());
+        return id;
+    }
+
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<uint32_t> offsets = {0};
+    std::string bytes;
+};
+
+template <class T>
+void writeArray(std::ofstream &out, const std::vector<T> &values) {
+    out.write(reinterpret_cast<const char *>(values.data()), (std::streamsize) (values.size() * sizeof(T)));
+}
+
+/**
+ * @brief Bounds-checked cursor over the sections of a mapped snapshot.
+ */
+class SnapshotCursor {
+public:
+    explicit SnapshotCursor(std::string_view data): data(data) {}
+
+    /**
+     * @brief Takes the next section of count elements of type T.
+     *
+     * @return A pointer to the section, or nullptr if the snapshot is too short or the section is misaligned.
+     */
+    template <class T>
+    const T *take(size_t count) {
+        if (count > (data.size() - offset) / sizeof(T)) return nullptr;
+        const char *p = data.data() + offset;
+        if (reinterpret_cast<uintptr_t>(p) % alignof(T) != 0) return nullptr;
+        offset += count * sizeof(T);
+        return reinterpret_cast<const T *>(p);
+    }
+
+    bool atEnd() const {
+        return offset == data.size();
+    }
+
+private:
+    std::string_view data;
+    size_t offset = 0;
+};
+
+}
+
+uint64_t snapshotStamp(const std::vector<std::string> &paths) {
+    uint64_t stamp = 1469598103934665603ULL;    // FNV-1a offset basis
+    auto mix = [&stamp](uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            stamp ^= (value >> (8 * i)) & 0xFF;
+            stamp *= 1099511628211ULL;
+        }
+    };
+    for (const std::string &path : paths) {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(path, error);
+        if (error) return 0;
+        auto modified = std::filesystem::last_write_time(path, error);
+        if (error) return 0;
+        mix(size);
+        mix((uint64_t) modified.time_since_epoch().count());
+    }
+    return stamp == 0 ? 1 : stamp;
+}
+
+void writeSnapshot(const Graph &railway, const std::string &path, uint64_t stamp) {
+    const std::vector<Vertex *> &vertices = railway.getVertexSet();
+    StringTableWriter strings;
+
+    std::vector<uint32_t> stations;
+    stations.reserve(vertices.size() * STATION_FIELDS);
+    std::vector<uint32_t> first = {0};
+    std::unordered_map<const Edge *, uint32_t> arcOf;
+    for (Vertex *v : vertices) {
+        stations.push_back(strings.intern(v->getName()));
+        stations.push_back(strings.intern(v->getDistrict()));
+        stations.push_back(strings.intern(v->getMunicipality()));
+        stations.push_back(strings.intern(v->getTownship()));
+        stations.push_back(strings.intern(v->getLine()));
+        for (Edge *e : v->getAdj()) {
+            arcOf.emplace(e, (uint32_t) arcOf.size());
+        }
+        first.push_back((uint32_t) arcOf.size());
+    }
+
+    size_t m = arcOf.size();
+    std::vector<double> capacity;
+    std::vector<uint32_t> head, reverse, service;
+    capacity.reserve(m);
+    head.reserve(m);
+    reverse.reserve(m);
+    service.reserve(m);
+    for (Vertex *v : vertices) {
+        for (Edge *e : v->getAdj()) {
+            auto r = arcOf.find(e->getReverse());
+            capacity.push_back(e->getWeight());
+            head.push_back((uint32_t) e->getDest()->getId());
+            reverse.push_back(r == arcOf.end() ? NO_ARC : r->second);
+            service.push_back(strings.intern(e->getService()));
+        }
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.stamp = stamp;
+    header.numStrings = (uint32_t) strings.offsets.size() - 1;
+    header.stringBytes = (uint32_t) strings.bytes.size();
+    header.numStations = (uint32_t) vertices.size();
+    header.numArcs = (uint32_t) m;
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Error writing " + temporary);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        writeArray(out, capacity);
+        writeArray(out, first);
+        writeArray(out, head);
+        writeArray(out, reverse);
+        writeArray(out, service);
+        writeArray(out, stations);
+        writeArray(out, strings.offsets);
+        out.write(strings.bytes.data(), (std::streamsize) strings.bytes.size());
+        if (!out) throw std::runtime_error("Error writing " + temporary);
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        throw std::runtime_error("Error writing " + path);
+    }
+}
+
+bool readSnapshot(Graph &railway, const std::string &path, uint64_t stamp) {
+    if (stamp == 0 || !railway.getVertexSet().empty()) return false;
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) return false;
+    std::unique_ptr<MappedFile> file;
+    try {
+        file = std::make_unique<MappedFile>(path);
+    } catch (const std::runtime_error &) {
+        return false;
+    }
+
+    SnapshotCursor cursor(file->getData());
+    const SnapshotHeader *header = cursor.take<SnapshotHeader>(1);
+    if (header == nullptr || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != FORMAT_VERSION ||
+        header->byteOrder != BYTE_ORDER_MARK || header->stamp != stamp) {
+        return false;
+    }
+    size_t n = header->numStations, m = header->numArcs, k = header->numStrings;
+    const double *capacity = cursor.take<double>(m);
+    const uint32_t *first = cursor.take<uint32_t>(n + 1);
+    const uint32_t *head = cursor.take<uint32_t>(m);
+    const uint32_t *reverse = cursor.take<uint32_t>(m);
+    const uint32_t *service = cursor.take<uint32_t>(m);
+    const uint32_t *stations = cursor.take<uint32_t>(n * STATION_FIELDS);
+    const uint32_t *offsets = cursor.take<uint32_t>(k + 1);
+    const char *bytes = cursor.take<char>(header->stringBytes);
+    if (bytes == nullptr || !cursor.atEnd()) return false;
+
+    // Validate every index before building anything
+    if (offsets[0] != 0 || offsets[k] != header->stringBytes) return false;
+    for (size_t i = 0; i < k; i++) {
+        if (offsets[i] > offsets[i + 1]) return false;
+    }
+    for (size_t i = 0; i < n * STATION_FIELDS; i++) {
+        if (stations[i] >= k) return false;
+    }
+    if (first[0] != 0 || first[n] != m) return false;
+    for (size_t i = 0; i < n; i++) {
+        if (first[i] > first[i + 1]) return false;
+    }
+    // The snapshot may come from a build with another capacity type, its capacities must be as acceptable as in the CSV
+    for (size_t a = 0; a < m; a++) {
+        if (head[a] >= n || service[a] >= k || !isExactCapacity<Capacity>(capacity[a])) return false;
+        if (reverse[a] != NO_ARC && (reverse[a] >= m || reverse[reverse[a]] != a)) return false;
+    }
+
+    auto viewAt = [offsets, bytes](uint32_t id) {
+        return std::string_view(bytes + offsets[id], offsets[id + 1] - offsets[id]);
+    };
+    std::unordered_set<std::string_view> names;
+    names.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        if (!names.insert(viewAt(stations[i * STATION_FIELDS])).second) return false;
+    }
+
+    // Each distinct string is interned once, stations and segments are then added by code
+    StringTable &strings = railway.getStrings();
+    std::vector<uint32_t> codes(k);
+    for (size_t i = 0; i < k; i++) {
+        codes[i] = strings.intern(viewAt((uint32_t) i));
+    }
+    for (size_t i = 0; i < n; i++) {
+        const uint32_t *fields = stations + i * STATION_FIELDS;
+        railway.addVertex(codes[fields[0]], codes[fields[1]], codes[fields[2]], codes[fields[3]], codes[fields[4]]);
+    }
+
+    // Adding arcs in CSR order rebuilds every adjacency list exactly as it was written
+    const std::vector<Vertex *> &vertices = railway.getVertexSet();
+    std::vector<Edge *> edges(m);
+    for (size_t i = 0; i < n; i++) {
+        for (uint32_t a = first[i]; a < first[i + 1]; a++) {
+            edges[a] = vertices[i]->addEdge(vertices[head[a]], capacity[a], codes[service[a]]);
+        }
+    }
+    for (size_t a = 0; a < m; a++) {
+        if (reverse[a] != NO_ARC) edges[a]->setReverse(edges[reverse[a]]);
+    }
+    return true;
+}
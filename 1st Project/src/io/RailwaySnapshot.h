@@ -0,0 +1,67 @@
+#ifndef G16_3_RAILWAYSNAPSHOT_H
+#define G16_3_RAILWAYSNAPSHOT_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../data_structures/Graph.h"
+
+/*
+ * Snapshot layout (native byte order, every section aligned to its element size):
+ *
+ *   header     magic "G16SNAP", format version, byte order mark, source stamp and the section sizes
+ *   capacity   double[numArcs]                 capacity of every arc, in CSR order
+ *   first      uint32[numStations + 1]         CSR offsets: the arcs of station i are first[i] .. first[i + 1] - 1
+ *   head       uint32[numArcs]                 destination station of every arc
+ *   reverse    uint32[numArcs]                 opposite arc of the same segment, or NO_ARC
+ *   service    uint32[numArcs]                 service of every arc, as a string id
+ *   stations   uint32[numStations * 5]         name, district, municipality, township and line string ids
+ *   offsets    uint32[numStrings + 1]          string table: string i is bytes offsets[i] .. offsets[i + 1] - 1
+ *   bytes      char[stringBytes]
+ *
+ * Every distinct string is stored once, so district, municipality, line and service names are shared across stations and arcs.
+ */
+
+/**
+ * @brief Computes a stamp identifying the current contents of a set of source files.
+ *
+ * The stamp combines the size and last modification time of every file, so a snapshot taken from those files can tell
+ * whether they have changed since.
+ *
+ * @param paths The paths of the source files.
+ * @return The stamp, or 0 if any of the files cannot be inspected.
+ */
+uint64_t snapshotStamp(const std::vector<std::string> &paths);
+
+/**
+ * @brief Writes a binary snapshot of a railway graph.
+ *
+ * The snapshot is written to a temporary file which then replaces path, so a reader never sees a partial snapshot.
+ *
+ * @param railway The graph to be written.
+ * @param path The path of the snapshot.
+ * @param stamp The stamp of the files the graph was read from, see snapshotStamp().
+ * @throw std::runtime_error If the snapshot cannot be written.
+ *
+ * Time Complexity: O(V + E)
+ */
+void writeSnapshot(const Graph &railway, const std::string &path, uint64_t stamp);
+
+/**
+ * @brief Reads a binary snapshot into an empty railway graph.
+ *
+ * The snapshot is memory-mapped and fully validated before the graph is touched, so a missing, stale, truncated or
+ * corrupted snapshot, or one with a capacity that Capacity cannot hold exactly (as readNetwork() would reject), leaves the
+ * graph empty and the caller can fall back to the CSV files. Each string of the snapshot is
+ * interned once in the string table of the graph, and stations and segments are then added by code, without building a
+ * string per field or per segment.
+ *
+ * @param railway The graph to be filled. It must be empty.
+ * @param path The path of the snapshot.
+ * @param stamp The stamp the snapshot must have been written with, see snapshotStamp().
+ * @return true if the snapshot was loaded, false otherwise.
+ *
+ * Time Complexity: O(V + E)
+ */
+bool readSnapshot(Graph &railway, const std::string &path, uint64_t stamp);
+
+#endif //G16_3_RAILWAYSNAPSHOT_H
@@ -3,95 +3,28 @@
 #include <sstream>
 #include <stdexcept>
 #include <chrono>
-#include <unordered_map>
 #include "data_structures/Graph.h"
+#include "io/RailwayReader.h"
+#include "io/BatchQueries.h"
 
 
 using namespace std;
 /**
 
-@brief Parses a line of CSV (Comma-Separated Values) and returns a vector of fields.
-This function takes a line of text in CSV format and splits it into fields using commas as delimiters.
-Fields enclosed in double quotes are treated as a single field, even if they contain commas.
-The resulting fields are stored in a vector of strings.
-@param line The input string containing the CSV line to be parsed.
-@return A vector of strings representing the fields extracted from the CSV line.
-*/
-vector<string> parse_csv_line(const std::string& line);
-
-/**
-
-@brief Reads station information from a CSV file and stores it in an unordered map.
-This function reads station information from a CSV file, where each line represents a station
-with various attributes separated by commas. The information is parsed using the parse_csv_line()
-function, and a new Vertex object is created for each station using the parsed fields. The Vertex
-objects are added to a Graph object, and the station names are used as keys in an unordered map
-to store the corresponding Vertex pointers.
-@param railway A reference to the Graph object to which the Vertex objects will be added.
-@return An unordered map with station names as keys and Vertex pointers as values.
-@throw runtime_error If the stations.csv file cannot be opened.
-*/
-unordered_map<string, Vertex *> readStations(Graph& railway);
+@brief Asks which stations and connections to remove to create a reduced subgraph of the Graph.
 
-/**
+This function allows the user to interactively describe a reduced subgraph of the Graph by
 
-@brief Reads network information from a CSV file and updates a Graph object.
-This function reads network information from a CSV file, where each line represents a connection
-between two stations with various attributes separated by commas. The information is parsed using
-the parse_csv_line() function, and the corresponding Vertex pointers are retrieved from the
-provided unordered map of stations. The railway Graph object is then updated with bidirectional
-edges between the stations using the addBidirectionalEdge() function, with the parsed attributes
-such as weight and edge label.
-@param railway A reference to the Graph object to be updated with network information.
-@param stations An unordered map with station names as keys and Vertex pointers as values.
-@throw runtime_error If the network.csv file cannot be opened.
-*/
-void readNetwork(Graph& railway,unordered_map<string, Vertex *> stations);
+choosing stations and connections between stations to remove. It prompts the user for input, validates
 
-/**
+it against the Graph object 'railway', and disables the chosen stations and connections in a Scenario,
 
-@brief Reads railway information from CSV files and updates a Graph object.
-This function reads railway information from two CSV files: stations.csv and network.csv. The
-stations.csv file contains station information, which is read using the readStations() function
-to populate an unordered map with station names as keys and Vertex pointers as values. The
-network.csv file contains network information, which is read using the readNetwork() function to
-update the Graph object with bidirectional edges between stations based on the station map
-obtained from readStations().
-@param railway A reference to the Graph object to be updated with railway information.
-@throw runtime_error If the stations.csv or network.csv files cannot be opened.
-*/
-void read(Graph& railway);
-
-/**
-
-@brief Performs Breadth-First Search (BFS) algorithm to find a path from source to destination in a Graph.
-This function implements the Breadth-First Search (BFS) algorithm to find a path from a given source
-Vertex to a destination Vertex in a Graph. It uses a queue data structure to explore the Graph in
-breadth-first order, starting from the source Vertex. The Graph is assumed to have already been
-populated with Vertex and Edge objects, and their visited and path states are updated during the BFS
-traversal.
-@param source Pointer to the source Vertex from where the BFS traversal starts.
-@param destination Pointer to the destination Vertex that is being searched for.
-@param railway A reference to the Graph object in which the BFS traversal is performed.
-@return true if a path is found from source to destination, false otherwise.
-*/
-bool bfs(Vertex* source, Vertex* destination, Graph& railway);
-
-/**
-
-@brief Creates a reduced subgraph of the Graph by removing stations and connections.
-
-This function allows the user to interactively create a reduced subgraph of the Graph by
-
-removing stations and connections between stations. It prompts the user for input to remove
-
-stations and connections, and performs the necessary operations on the Graph object 'railway'
-
-to create the reduced subgraph.
+without modifying the Graph.
 
 @param railway A reference to the Graph object for which the reduced subgraph is to be created.
+@param scenario The scenario, created with railway.createScenario(), that receives the removals.
 */
-void createReducedGraph(Graph &railway);
+void createReducedGraph(Graph &railway, Scenario &scenario);
 
 /**
 
@@ -140,15 +73,26 @@ void basicServiceMetrics(Graph& railway); // 4.1
 
 /**
 
+@brief Asks the user which max-flow algorithm should be used.
+This function displays the available max-flow algorithms and reads the user's choice, prompting again until a valid
+option is entered.
+@return The selected max-flow algorithm.
+*/
+FlowAlgorithm chooseFlowAlgorithm();
+
+/**
+
 @brief Calculates the maximum number of trains that can simultaneously travel between two specific stations in a railway network.
 This function prompts the user to enter the names of the source and destination stations.
 It then calls the Edmonds-Karp algorithm on the Graph object to find the maximum flow between the source and destination stations,
 which represents the maximum number of trains that can simultaneously travel between the two stations.
 The calculated result is displayed on the console.
 @param railway A reference to a Graph object representing the railway network.
+@param algorithm The max-flow algorithm to use.
+@param scenario Scenario of a reduced network to evaluate instead of the full network, or nullptr.
 @return void
 */
-void maxTrainsBetweenStations(Graph& railway);
+void maxTrainsBetweenStations(Graph& railway, FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp, const Scenario *scenario = nullptr);
 
 /**
 
@@ -159,9 +103,10 @@ The maximum flow represents the maximum number of trains that can simultaneously
 The function then determines which stations require the most amount of trains based on the calculated maximum flows,
 and displays the results on the console.
 @param railway A reference to a Graph object representing the railway network.
+@param algorithm The max-flow algorithm to use.
 @return void
 */
-void mostTrainsRequired(Graph& railway);
+void mostTrainsRequired(Graph& railway, FlowAlgorithm algorithm);
 
 /**
 
@@ -173,9 +118,10 @@ such as passenger demand, train usage, and revenue generated.
 The function then displays the results on the console, indicating the districts and municipalities that require
 larger budgets for train operations.
 @param railway A reference to a Graph object representing the railway network.
+@param algorithm The max-flow algorithm to use.
 @return void
 */
-void assignBudgets(Graph& railway);
+void assignBudgets(Graph& railway, FlowAlgorithm algorithm);
 
 /**
 
@@ -210,11 +156,9 @@ This function takes a railway network represented by a Graph object and prompts
 
 station names. It then calculates the maximum amount of trains that can simultaneously travel between the source and destination
 
-stations with minimum cost, using the Ford-Fulkerson algorithm with the BFS-based augmenting path finding method. The function
+stations with minimum cost, using the successive shortest path min-cost flow of Graph::minCostTrains(), where every train pays
 
-updates the flow along the augmenting path with the optimal service type, and keeps track of the maximum flow and total cost of
-
-trains allocated along the augmenting path. Finally, it prints the maximum flow and total cost to the console.
+the cost of the service of each segment it crosses. Finally, it prints the maximum flow and total cost to the console.
 
 @param railway A reference to a Graph object representing the railway network.
 
@@ -225,9 +169,10 @@ void minCostTrains(Graph& railway);
 /**
 
 @brief Generates a report on stations that are the most affected by each segment failure or calculates the maximum number of trains that can simultaneously travel between two specific stations in a network of reduced connectivity.
-This function presents a menu with three options:
+This function presents a menu with four options:
 Calculate the maximum number of trains that can simultaneously travel between two specific stations in a network of reduced connectivity.
 Provide a report on the stations that are the most affected by each segment failure.
+Rank every segment by the flow lost when it fails on its own (N-1 contingency sweep).
 Return to the previous menu.
 @param railway The Graph object representing the railway network.
 @return void
@@ -252,76 +197,95 @@ This function creates a reduced graph from the original railway network using th
 */
 void mostAffectedStations(Graph& railway);
 
-int main() {
+/**
+
+@brief Ranks every segment of the railway network by the maximum flow lost when it fails on its own.
+This function asks which origin-destination pairs to measure: either the k pairs with the most trains, or pairs of stations
+entered by the user. It then runs an N-1 contingency sweep with Graph::sweepSegmentFailures(), which evaluates the segments
+in parallel, and displays the segments that lose the most flow, with the number of affected pairs and the execution time.
+@param railway The Graph object representing the railway network.
+@return void
+*/
+void segmentFailureSweep(Graph& railway);
+
+/**
+
+@brief Runs the non-interactive batch mode selected by the command line arguments.
+The arguments are --batch followed by a file of queries, or - to read them from the standard input, and optionally
+--format csv|json, --algorithm edmonds-karp|dinic|push-relabel and --threads N. The results are written to the standard
+output by runBatch(), while usage errors, the hit and miss counters of the result cache and the work of the max-flow solvers are reported on
+the standard error.
+@param railway A reference to the Graph object the queries are answered on.
+@param argc The number of command line arguments.
+@param argv The command line arguments.
+@return The exit status of the program: 0 if every query succeeded, 1 otherwise.
+*/
+int batchMode(Graph& railway, int argc, char *argv[]);
+
+int main(int argc, char *argv[]) {
     Graph railway = Graph();
-    read(railway);
+    try {
+        read(railway);
+    } catch (const std::runtime_error &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    if (argc > 1) {
+        return batchMode(railway, argc, argv);
+    }
     interface(railway);
     return 0;
 }
 
-vector<string> parse_csv_line(const std::string& line) {
-    vector<std::string> fields;
-    string field;
-    bool in_quotes = false;
-
-    for (size_t i = 0; i < line.length(); ++i) {
-        if (line[i] == '"') {
-            in_quotes = !in_quotes;
-            continue;
+int batchMode(Graph& railway, int argc, char *argv[]) {
+    BatchOptions options;
+    string input;
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++) {
+        string arg = argv[i];
+        if (i + 1 == argc) {
+            valid = false;
+            break;
         }
-        if (line[i] == ',' && !in_quotes) {
-            fields.push_back(field);
-            field.clear();
+        string value = argv[++i];
+        if (arg == "--batch") {
+            input = value;
+        } else if (arg == "--format" && (value == "csv" || value == "json")) {
+            options.format = value == "csv" ? BatchFormat::Csv : BatchFormat::Json;
+        } else if (arg == "--algorithm" && value == "edmonds-karp") {
+            options.algorithm = FlowAlgorithm::EdmondsKarp;
+        } else if (arg == "--algorithm" && value == "dinic") {
+            options.algorithm = FlowAlgorithm::Dinic;
+        } else if (arg == "--algorithm" && value == "push-relabel") {
+            options.algorithm = FlowAlgorithm::PushRelabel;
+        } else if (arg == "--threads") {
+            options.threads = (unsigned) strtoul(value.c_str(), nullptr, 10);
         } else {
-            field += line[i];
+            valid = false;
         }
     }
-    fields.push_back(field);
-    return fields;
-}
-
-unordered_map<string, Vertex *> readStations(Graph& railway) {
-    ifstream fin("../dataset/stations.csv");
-    string line;
-    unordered_map<string, Vertex *> stations;
-    if (!fin.is_open()) {
-        throw runtime_error("Error reading stations.csv");
-    }
-    getline(fin, line);
-    while (getline(fin, line)) {
-        if (line[line.size() - 1] == '\r') {
-            line.pop_back();
-        }
-        vector<string> curr = parse_csv_line(line);
-        Vertex *vertex = new Vertex(curr[0], curr[1], curr[2], curr[3], curr[4]);
-        railway.addVertex(vertex);
-        stations.insert(make_pair(curr[0], vertex));
+    if (!valid || input.empty()) {
+        cerr << "Usage: " << argv[0] << " --batch <queries file|-> [--format csv|json] [--algorithm edmonds-karp|dinic|push-relabel] [--threads N]" << endl;
+        return 1;
     }
-    fin.close();
-    return stations;
-}
 
-void readNetwork(Graph& railway,unordered_map<string, Vertex *> stations){
-    ifstream fin("../dataset/network.csv");
-    string line;
-    if(!fin.is_open()) {
-        throw runtime_error("Error reading network.csv");
-    }
-    getline(fin, line);
-    while (getline(fin, line)) {
-        if (line[line.size() - 1] == '\r') {
-            line.pop_back();
+    size_t errors;
+    if (input == "-") {
+        errors = runBatch(railway, cin, cout, options);
+    } else {
+        ifstream fin(input);
+        if (!fin) {
+            cerr << "Error reading " << input << endl;
+            return 1;
         }
-        vector<string> curr = parse_csv_line(line);
-        Vertex* stationA = stations.find(curr[0])->second;
-        Vertex* stationB = stations.find(curr[1])->second;
-        railway.addBidirectionalEdge(stationA,stationB,stod(curr[2]),curr[3]);
+        errors = runBatch(railway, fin, cout, options);
     }
-    fin.close();
-}
-
-void read(Graph& railway){
-    readNetwork(railway, readStations(railway));
+    ResultCache &cache = railway.getResultCache();
+    cerr << "Result cache: " << cache.getHits() << " hits, " << cache.getMisses() << " misses" << endl;
+    cerr << "Flow stats: ";
+    railway.getFlowStats().dump(cerr);
+    cerr << endl;
+    return errors == 0 ? 0 : 1;
 }
 
 void interface(Graph& railway){
@@ -370,15 +334,17 @@ void basicServiceMetrics(Graph& railway){
         cin >> option;
     }
     switch (option) {
-        case 1:
+        case 1: {
+            FlowAlgorithm algorithm = chooseFlowAlgorithm();
             std::cin.ignore();
-            maxTrainsBetweenStations(railway);
+            maxTrainsBetweenStations(railway, algorithm);
             break;
+        }
         case 2:
-            mostTrainsRequired(railway);
+            mostTrainsRequired(railway, chooseFlowAlgorithm());
             break;
         case 3:
-            assignBudgets(railway);
+            assignBudgets(railway, chooseFlowAlgorithm());
             break;
         case 4:
             maxTrainsAtStation(railway);
@@ -389,6 +355,29 @@ void basicServiceMetrics(Graph& railway){
     }
 }
 
+FlowAlgorithm chooseFlowAlgorithm() {
+    int option;
+    cout << "\nMax-flow algorithm:" << endl;
+    cout << "1. - Edmonds-Karp" << endl;
+    cout << "2. - Dinic" << endl;
+    cout << "3. - Push-Relabel\n" << endl;
+    cout << "Enter your option: ";
+    cin >> option;
+    while (option < 1 || option > 3) {
+        cout << "This option is not valid, try again!" << endl;
+        cout << "Option:";
+        cin >> option;
+    }
+    switch (option) {
+        case 2:
+            return FlowAlgorithm::Dinic;
+        case 3:
+            return FlowAlgorithm::PushRelabel;
+        default:
+            return FlowAlgorithm::EdmondsKarp;
+    }
+}
+
 void operationCostOptimization(Graph& railway) {
     int option;
     cout << "\n--- Operations Cost Optimization ---\n" << endl;
@@ -415,10 +404,11 @@ void randStoLineFailures(Graph& railway){
     int option;
     cout << "1. - Calculate the maximum number of trains that can simultaneously travel between two specific stations in a network of reduced connectivity" << endl;
     cout << "2. - Provide a report on the stations that are the most affected by each segment failure" << endl;
-    cout << "3. - Return\n" << endl;
+    cout << "3. - Rank the segments by the flow lost when each one fails" << endl;
+    cout << "4. - Return\n" << endl;
     cout << "Enter your option: ";
     cin >> option;
-    while (option < 1 || option > 3) {
+    while (option < 1 || option > 4) {
         cout << "This option is not valid, try again!" << endl;
         cout << "Option:";
         cin >> option;
@@ -431,12 +421,15 @@ void randStoLineFailures(Graph& railway){
             mostAffectedStations(railway);
             break;
         case 3:
+            segmentFailureSweep(railway);
+            break;
+        case 4:
             interface(railway);
             break;
 
     }
 }
-void maxTrainsBetweenStations(Graph& railway){
+void maxTrainsBetweenStations(Graph& railway, FlowAlgorithm algorithm, const Scenario *scenario){
     std::string sourceName;
     int option;
     std::cout << "Enter source station name: ";
@@ -456,15 +449,18 @@ void maxTrainsBetweenStations(Graph& railway){
         std::cout << "Destination station not found." << std::endl;
         return;
     }
-    double maxTrains = railway.EdmondsKarp(source, destination);
+    double maxTrains = scenario == nullptr ? railway.maxFlow(source, destination, algorithm) : railway.maxFlow(source, destination, algorithm, *scenario);
     std::cout << "Max trains between " << sourceName << " and " << destName << " is " << maxTrains << endl;
 }
 
-void mostTrainsRequired(Graph& railway){
-    railway.MaxFlowBetweenPairs();
+void mostTrainsRequired(Graph& railway, FlowAlgorithm algorithm){
+    auto start = chrono::high_resolution_clock::now();
+    railway.MaxFlowBetweenPairs(algorithm);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Tempo de execução: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
 }
 
-void assignBudgets(Graph& railway){
+void assignBudgets(Graph& railway, FlowAlgorithm algorithm){
     int option;
     int k;
     cout << "1 - Top Districts" << endl;
@@ -474,10 +470,10 @@ void assignBudgets(Graph& railway){
     cin >> k;
     switch (option) {
         case 1:
-            railway.topDistricts(k);
+            railway.topDistricts(k, algorithm);
             break;
         case 2:
-            railway.topMunicipalities(k);
+            railway.topMunicipalities(k, algorithm);
             break;
 
     }
@@ -518,95 +514,15 @@ void minCostTrains(Graph& railway) {
         return;
     }
 
-    int maxFlow = 0;
-    double totalCost = 0.0; // Total cost of trains allocated along augmenting path
-
-    // Initialize residual graph with the same capacities as original graph
-    for (Vertex* v : railway.getVertexSet()) {
-        for (Edge* e : v->getAdj()) {
-            e->setFlow(0);
-        }
-    }
-
-    // Loop until there is an augmenting path from source to destination
-    while (bfs(source, destination, railway)) {
-        // Find the bottleneck capacity along the augmenting path
-        double bottleneck = INF;
-        Vertex* v = destination;
-        std::string optimalServiceType = ""; // Stores the optimal service type for the bottleneck capacity
-        while (v != source) {
-            Edge* e = v->getPath();
-            double remainingCapacity = e->getWeight() - e->getFlow();
-            std::string service = e->getService();
-            double cost = 0.0;
-            if (service == "STANDARD") {
-                cost = 2.0; // Standard service cost is 2€ per train
-            } else if (service == "ALFA PENDULAR") {
-                cost = 4.0; // Alpha service cost is 4€ per train
-            } else {
-                std::cout << "Invalid service type encountered: " << service << std::endl;
-                return;
-            }
-            // Calculate the cost of trains for the remaining capacity of the edge
-            double trainCost = cost * remainingCapacity;
-            // Update the optimal service type if the current service type has lower cost per train
-            if (optimalServiceType.empty() || trainCost < (cost * bottleneck)) {
-                bottleneck = remainingCapacity;
-                optimalServiceType = service;
-            }
-            v = e->getOrig();
-        }
-
-        // Update the flow along the augmenting path with the optimal service type
-        v = destination;
-        while (v != source) {
-            Edge* e = v->getPath();
-            e->setFlow(e->getFlow() + bottleneck);
-            e->getReverse()->setFlow(e->getReverse()->getFlow() - bottleneck);
-            v = e->getOrig();
-        }
-
-        maxFlow += bottleneck;
-        // Update the total cost with the cost of trains allocated using the optimal service type
-        if (optimalServiceType == "STANDARD") {
-            totalCost += 2.0 * bottleneck;
-        } else if (optimalServiceType == "ALFA PENDULAR") {
-            totalCost += 4.0 * bottleneck;
-        }
-    }
-
-    std::cout << "Max Flow between " << sourceName << " and " << destName << " is " << maxFlow << ", with Min Cost " << totalCost << "€" << endl;
-}
-
-// Function to perform breadth-first search (BFS) to find an augmenting path
-bool bfs(Vertex* source, Vertex* destination, Graph& railway) {
-    for (Vertex* v : railway.getVertexSet()) {
-        v->setVisited(false);
-        v->setPath(nullptr);
-    }
-
-    std::queue<Vertex*> queue;
-    queue.push(source);
-    source->setVisited(true);
-
-    while (!queue.empty()) {
-        Vertex* v = queue.front();
-        queue.pop();
-
-        for (Edge* e : v->getAdj()) {
-            Vertex* u = e->getDest();
-            if (!u->isVisited() && e->getWeight() > e->getFlow()) {
-                u->setVisited(true);
-                u->setPath(e);
-                queue.push(u);
-            }
-        }
+    try {
+        std::pair<double, double> result = railway.minCostTrains(source, destination);
+        std::cout << "Max Flow between " << sourceName << " and " << destName << " is " << result.first << ", with Min Cost " << result.second << "€" << endl;
+    } catch (const std::runtime_error &e) {
+        std::cout << e.what() << std::endl;
     }
-
-    return destination->isVisited();
 }
 
-void createReducedGraph(Graph& railway) {
+void createReducedGraph(Graph& railway, Scenario &scenario) {
     cout << "Create the reduced subgraph" << endl << endl;
     char opt = 'n';
 
@@ -621,7 +537,8 @@ void createReducedGraph(Graph& railway) {
         string stationName;
         getline(cin, stationName);
 
-        if (!railway.removeVertex(stationName)) {
+        Vertex *station = railway.findVertex(stationName);
+        if (station == nullptr || !scenario.disableStation(station)) {
             cout << "Invalid station!\n";
         }
 
@@ -696,7 +613,7 @@ void createReducedGraph(Graph& railway) {
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
                 if (opt == 'y' || opt == 'Y') {
-                    found = origin->removeEdge(dest->getName());
+                    found = scenario.disableEdge(e) || found;
                 }
             }
         }
@@ -749,15 +666,16 @@ void pause() {
 }
 
 void maxTrainsReducedConnectivity(Graph& railway){
-    createReducedGraph(railway);
+    Scenario scenario = railway.createScenario();
+    createReducedGraph(railway, scenario);
     cout << "Max Trains Between Stations in the subgraph" << endl << endl;
-    maxTrainsBetweenStations(railway);
+    maxTrainsBetweenStations(railway, FlowAlgorithm::EdmondsKarp, &scenario);
 }
 
 void mostAffectedStations(Graph& railway){
-    Graph rc = railway;
-    createReducedGraph(rc);
-    std::vector<std::string>v = railway.MostAffectStations(rc);
+    Scenario scenario = railway.createScenario();
+    createReducedGraph(railway, scenario);
+    std::vector<std::string>v = railway.MostAffectStations(scenario);
     if(v.empty()){
         std::cout << "There are no segment failures \n";
         pause();
@@ -769,3 +687,69 @@ void mostAffectedStations(Graph& railway){
     }
     pause();
 }
+
+void segmentFailureSweep(Graph& railway){
+    FlowAlgorithm algorithm = chooseFlowAlgorithm();
+    int option;
+    cout << "1. - Measure the flow lost by the pairs of stations with the most trains" << endl;
+    cout << "2. - Measure the flow lost by specific pairs of stations\n" << endl;
+    cout << "Enter your option: ";
+    cin >> option;
+    while (option < 1 || option > 2) {
+        cout << "This option is not valid, try again!" << endl;
+        cout << "Option:";
+        cin >> option;
+    }
+
+    vector<pair<Vertex *, Vertex *>> pairs;
+    if (option == 1) {
+        int k;
+        cout << "Number of pairs: ";
+        cin >> k;
+        pairs = railway.topPairs(k);
+    } else {
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        char opt = 'y';
+        while (opt == 'y' || opt == 'Y') {
+            string originName, destName;
+            cout << "Enter source station name: ";
+            getline(cin, originName);
+            cout << "Enter destination station name: ";
+            getline(cin, destName);
+            Vertex *origin = railway.findVertex(originName);
+            Vertex *dest = railway.findVertex(destName);
+            if (origin == nullptr || dest == nullptr) {
+                cout << "Invalid station!\n";
+            } else {
+                pairs.emplace_back(origin, dest);
+            }
+            cout << "Want to add another pair? (y/n): ";
+            cin >> opt;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+    }
+    if (pairs.empty()) {
+        cout << "There are no pairs to measure \n";
+        return;
+    }
+
+    int shown;
+    cout << "Number of segments to show: ";
+    cin >> shown;
+
+    auto start = chrono::high_resolution_clock::now();
+    ContingencySweep sweep = railway.sweepSegmentFailures(pairs, algorithm);
+    auto end = chrono::high_resolution_clock::now();
+
+    cout << "Total flow of the " << pairs.size() << " pair(s): " << sweep.getBaseFlow() << endl;
+    int rank = 0;
+    for (const SegmentFailure &failure : sweep.getRanking()) {
+        if (rank == shown || failure.loss <= 0.0) break;
+        cout << ++rank << ". " << failure.origin->getName() << " - " << failure.destination->getName() << " (capacity " << failure.capacity
+             << "): loses " << failure.loss << " over " << failure.affectedPairs << " pair(s)" << endl;
+    }
+    if (rank == 0) {
+        cout << "No single segment failure reduces the flow of these pairs" << endl;
+    }
+    cout << "Tempo de execução: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+}